@@ -0,0 +1,54 @@
+#include "synthetic.hpp"
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/rapidjson.hpp>
+#include <maplibre/geojson/simdjson.hpp>
+
+#include <nanobench.h>
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace maplibre::geojson;
+
+static void compare(const std::string &title, const std::string &json) {
+    ankerl::nanobench::Bench bench;
+    bench.title(title).unit("byte").batch(json.size()).relative(true);
+
+    bench.run("parse_rapidjson", [&] { ankerl::nanobench::doNotOptimizeAway(parse_rapidjson(json)); });
+    bench.run("parse_simdjson", [&] { ankerl::nanobench::doNotOptimizeAway(parse_simdjson(json)); });
+}
+
+// Run from the repository root, for the fixtures.
+int main() {
+    std::vector<std::filesystem::path> fixtures;
+    for (const auto &entry : std::filesystem::directory_iterator("test/fixtures")) {
+        fixtures.push_back(entry.path());
+    }
+    std::sort(fixtures.begin(), fixtures.end());
+
+    for (const auto &path : fixtures) {
+        std::ifstream input(path);
+        std::stringstream buffer;
+        buffer << input.rdbuf();
+        const std::string json = buffer.str();
+
+        // Invalid fixtures only measure the error path, which is rapidjson's for both.
+        try {
+            parse(json);
+        } catch (const std::exception &) {
+            continue;
+        }
+        compare(path.filename().string(), json);
+    }
+
+    compare("synthetic polygons", stringify(bench::polygons(20000, 64)));
+    compare("synthetic tagged points", stringify(bench::tagged(200000, 24)));
+
+    return 0;
+}
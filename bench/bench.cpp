@@ -0,0 +1,84 @@
+#include "synthetic.hpp"
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/interned.hpp>
+#include <maplibre/geojson/pmr.hpp>
+#include <maplibre/geojson/rapidjson.hpp>
+
+#include <nanobench.h>
+
+#include <iostream>
+#include <memory_resource>
+
+using namespace maplibre::geojson;
+
+int main() {
+    const auto collection  = bench::polygons(2000, 64);
+    const std::string json = stringify(collection);
+
+    ankerl::nanobench::Bench parsing;
+    parsing.title("parse FeatureCollection").unit("byte").batch(json.size()).relative(true);
+
+    parsing.run("rapidjson_document + convert", [&] {
+        rapidjson_document d;
+        d.Parse(json.c_str());
+        ankerl::nanobench::doNotOptimizeAway(convert<geojson>(d));
+    });
+
+    convert_options allThreads;
+    allThreads.threads = 0;
+    parsing.run("rapidjson_document + convert, all threads", [&] {
+        rapidjson_document d;
+        d.Parse(json.c_str());
+        ankerl::nanobench::doNotOptimizeAway(convert<geojson>(d, allThreads));
+    });
+
+    parsing.run("parse", [&] { ankerl::nanobench::doNotOptimizeAway(parse(json)); });
+
+    const std::string tagged = stringify(bench::tagged(20000, 24));
+
+    ankerl::nanobench::Bench properties;
+    properties.title("parse property-heavy FeatureCollection").unit("byte").batch(tagged.size()).relative(true);
+
+    properties.run("parse", [&] { ankerl::nanobench::doNotOptimizeAway(parse(tagged)); });
+
+    // Includes restoring the buffer, which parse_insitu overwrites.
+    std::string buffer;
+    properties.run("parse_insitu", [&] {
+        buffer = tagged;
+        ankerl::nanobench::doNotOptimizeAway(parse_insitu(buffer.data(), buffer.size()));
+    });
+
+    // Copies no key or string value: the result refers to them within the buffer.
+    properties.run("interned::parse_insitu", [&] {
+        buffer = tagged;
+        ankerl::nanobench::doNotOptimizeAway(interned::parse_insitu(buffer.data(), buffer.size()));
+    });
+
+    // Destroying the result is part of the cost: per-node frees on the heap, one release for an arena.
+    ankerl::nanobench::Bench lifetime;
+    lifetime.title("parse and destroy property-heavy FeatureCollection")
+        .unit("byte")
+        .batch(tagged.size())
+        .relative(true);
+
+    lifetime.run("parse", [&] { ankerl::nanobench::doNotOptimizeAway(parse(tagged).index()); });
+
+    lifetime.run("pmr::parse, monotonic_buffer_resource", [&] {
+        std::pmr::monotonic_buffer_resource arena;
+        ankerl::nanobench::doNotOptimizeAway(pmr::parse(tagged, &arena).index());
+    });
+
+    ankerl::nanobench::Bench output;
+    output.title("stringify FeatureCollection").unit("feature").batch(collection.size()).relative(true);
+
+    for (const int decimals : { -1, 7, 6 }) {
+        const stringify_options options{ decimals };
+        std::cout << "max_decimals " << decimals << ": " << stringify(collection, options).size() << " bytes"
+                  << std::endl;
+        output.run("stringify, max_decimals " + std::to_string(decimals),
+                   [&] { ankerl::nanobench::doNotOptimizeAway(stringify(collection, options)); });
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Reports wall time and peak resident set size of a single parse. Peak RSS only ever grows within a
+// process, so every mode has to run in a process of its own:
+//
+//   bench_peak_memory document [file.geojson]
+//   bench_peak_memory parse [file.geojson]
+//   bench_peak_memory for_each_feature [file.geojson]
+//   bench_peak_memory parse_file [file.geojson]
+//
+// Without a file, a synthetic FeatureCollection is used; parse_file writes it to a temporary file first.
+// parse_file doesn't read the input into memory beforehand, so its input is part of the peak.
+
+#include "synthetic.hpp"
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/rapidjson.hpp>
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace maplibre::geojson;
+
+static long peakKilobytes() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+int main(int argc, char *argv[]) {
+    const std::string mode = argc > 1 ? argv[1] : "parse";
+
+    std::string json;
+    std::filesystem::path path;
+    if (argc > 2) {
+        path = argv[2];
+        if (mode != "parse_file") {
+            std::ifstream t(argv[2]);
+            std::stringstream buffer;
+            buffer << t.rdbuf();
+            json = buffer.str();
+        }
+    } else {
+        json = stringify(bench::polygons(20000, 64));
+        if (mode == "parse_file") {
+            path = std::filesystem::temp_directory_path() / "bench_peak_memory.geojson";
+            std::ofstream(path, std::ios::binary) << json;
+            json = std::string();
+        }
+    }
+
+    const long before = peakKilobytes();
+    const auto start  = std::chrono::steady_clock::now();
+
+    geojson result;
+    if (mode == "document") {
+        rapidjson_document d;
+        d.Parse(json.c_str());
+        result = convert<geojson>(d);
+    } else if (mode == "parse") {
+        result = parse(json);
+    } else if (mode == "parse_file") {
+        result = parse_file(path);
+    } else if (mode == "for_each_feature") {
+        std::size_t count = 0;
+        for_each_feature(json, [&](feature &&) { ++count; });
+    } else {
+        std::cerr << "unknown mode " << mode << std::endl;
+        return 1;
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+    const auto inputSize = mode == "parse_file" ? std::filesystem::file_size(path) : json.size();
+    std::cout << mode << ": " << inputSize / 1024 << " KiB input, " << elapsed.count() << " ms, peak RSS "
+              << peakKilobytes() << " KiB (" << peakKilobytes() - before << " KiB during parse)" << std::endl;
+    if (mode == "parse_file" && argc <= 2)
+        std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,144 @@
+// Compares feature properties kept in an unordered_map, as parse() keeps them, with those kept in a flat
+// property map, for features with a given number of properties:
+//
+//   bench_properties [count...]
+//
+// Prints the memory a feature's properties take, as the size of the map plus the bytes it holds on to
+// once they are inserted one by one like a parse does, and the latency of looking up a key that is
+// present and one that isn't. Keys and values are short enough not to allocate themselves.
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/flat.hpp>
+
+#include <nanobench.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace maplibre::geojson;
+
+// Bytes of live allocations, including what malloc rounds them up to.
+static std::atomic<std::size_t> allocatedBytes{ 0 };
+
+static void *allocate(std::size_t size) {
+    void *block = std::malloc(size ? size : 1);
+    if (!block)
+        throw std::bad_alloc();
+    allocatedBytes.fetch_add(malloc_usable_size(block), std::memory_order_relaxed);
+    return block;
+}
+
+static void deallocate(void *block) noexcept {
+    if (block)
+        allocatedBytes.fetch_sub(malloc_usable_size(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void *operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size) {
+    return allocate(size);
+}
+
+void operator delete(void *block) noexcept {
+    deallocate(block);
+}
+
+void operator delete[](void *block) noexcept {
+    deallocate(block);
+}
+
+void operator delete(void *block, std::size_t) noexcept {
+    deallocate(block);
+}
+
+void operator delete[](void *block, std::size_t) noexcept {
+    deallocate(block);
+}
+
+struct summary_row {
+    std::size_t properties;
+    std::string map;
+    double bytesPerFeature;
+    double presentNanoseconds;
+    double missingNanoseconds;
+};
+
+static constexpr std::size_t featureCount = 10000;
+
+template <class Map>
+static summary_row measure(const std::string &name, const std::vector<std::string> &keys) {
+    const std::vector<value> values = { std::string("residential"), std::uint64_t(2), true, 4.5 };
+
+    std::vector<Map> maps;
+    maps.reserve(featureCount);
+    const std::size_t before = allocatedBytes.load();
+    for (std::size_t i = 0; i < featureCount; ++i) {
+        Map &map = maps.emplace_back();
+        for (std::size_t k = 0; k < keys.size(); ++k) {
+            map.emplace(keys[k], values[(i + k) % values.size()]);
+        }
+    }
+    const double bytes = double(sizeof(Map)) + double(allocatedBytes.load() - before) / double(featureCount);
+
+    ankerl::nanobench::Bench bench;
+    bench.title(std::to_string(keys.size()) + " properties").minEpochIterations(100000).warmup(1000);
+
+    std::size_t next = 0;
+    bench.run(name + " present", [&] {
+        const auto &map = maps[next % featureCount];
+        ankerl::nanobench::doNotOptimizeAway(map.find(keys.empty() ? std::string() : keys[next % keys.size()]));
+        ++next;
+    });
+    const double present = bench.results().back().median(ankerl::nanobench::Result::Measure::elapsed) * 1e9;
+
+    const std::string missing = "name:en";
+    bench.run(name + " missing", [&] {
+        ankerl::nanobench::doNotOptimizeAway(maps[next++ % featureCount].find(missing));
+    });
+    const double absent = bench.results().back().median(ankerl::nanobench::Result::Measure::elapsed) * 1e9;
+
+    return { keys.size(), name, bytes, present, absent };
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::size_t> counts = { 0, 1, 2, 4, 8, 16, 32 };
+    if (argc > 1) {
+        counts.clear();
+        for (int i = 1; i < argc; ++i) {
+            counts.push_back(std::strtoul(argv[i], nullptr, 10));
+        }
+    }
+
+    std::vector<summary_row> summary;
+    for (const std::size_t count : counts) {
+        std::vector<std::string> keys;
+        for (std::size_t k = 0; k < count; ++k) {
+            keys.push_back("tag:" + std::to_string(k));
+        }
+
+        summary.push_back(measure<value::object_type>("unordered_map", keys));
+        summary.push_back(measure<flat::basic_property_map<0>>("flat::basic_property_map<0>", keys));
+        summary.push_back(measure<flat::property_map>("flat::property_map", keys));
+        summary.push_back(measure<flat::basic_property_map<4>>("flat::basic_property_map<4>", keys));
+    }
+
+    std::printf("\n| %10s | %-28s | %14s | %12s | %12s |\n", "properties", "map", "bytes/feature", "present ns",
+                "missing ns");
+    std::printf("|%s|%s|%s|%s|%s|\n", std::string(12, '-').c_str(), std::string(30, '-').c_str(),
+                std::string(16, '-').c_str(), std::string(14, '-').c_str(), std::string(14, '-').c_str());
+    for (const auto &row : summary) {
+        std::printf("| %10zu | %-28s | %14.1f | %12.2f | %12.2f |\n", row.properties, row.map.c_str(),
+                    row.bytesPerFeature, row.presentNanoseconds, row.missingNanoseconds);
+    }
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Measures every parse and conversion path on synthetic FeatureCollections of each geometry type:
+//
+//   bench_suite [dataset...]
+//
+// Alongside nanobench's tables, prints a summary with the throughput relative to the size of each
+// dataset's JSON and in features, and the heap allocations an operation makes per feature.
+
+#include "synthetic.hpp"
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/columnar.hpp>
+#include <maplibre/geojson/interned.hpp>
+#include <maplibre/geojson/rapidjson.hpp>
+#include <maplibre/geojson/value.hpp>
+
+#include <nanobench.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace maplibre::geojson;
+
+static std::atomic<std::size_t> allocations{ 0 };
+
+static void *allocate(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *block = std::malloc(size ? size : 1))
+        return block;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size) {
+    return allocate(size);
+}
+
+void operator delete(void *block) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void *block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void *block, std::size_t) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void *block, std::size_t) noexcept {
+    std::free(block);
+}
+
+struct dataset {
+    std::string name;
+    std::function<feature_collection()> generate;
+};
+
+struct summary_row {
+    std::string dataset;
+    std::string operation;
+    double megabytesPerSecond;
+    double featuresPerSecond;
+    double allocationsPerFeature;
+};
+
+int main(int argc, char *argv[]) {
+    const std::vector<dataset> datasets = {
+        { "points", [] { return bench::points(200000); } },
+        { "multi_points", [] { return bench::multiPoints(20000, 16); } },
+        { "line_strings", [] { return bench::lineStrings(20000, 64); } },
+        { "multi_line_strings", [] { return bench::multiLineStrings(5000, 8, 32); } },
+        { "polygons", [] { return bench::polygons(20000, 64); } },
+        { "large_polygons", [] { return bench::polygons(20, 50000); } },
+        { "multi_polygons", [] { return bench::multiPolygons(5000, 4, 48); } },
+        { "geometry_collections", [] { return bench::geometryCollections(10000, 8); } },
+        { "properties", [] { return bench::tagged(50000, 24); } },
+    };
+
+    std::vector<summary_row> summary;
+
+    for (const auto &set : datasets) {
+        if (argc > 1 && std::find(argv + 1, argv + argc, set.name) == argv + argc)
+            continue;
+
+        const geojson data{ set.generate() };
+        const std::string json     = stringify(data);
+        const std::size_t features = std::get<feature_collection>(data).size();
+
+        rapidjson_document document;
+        document.Parse(json.c_str());
+        const value dataValue = convert(data);
+
+        ankerl::nanobench::Bench bench;
+        bench.title(set.name).unit("byte").batch(json.size()).relative(true);
+
+        const auto measure = [&](const std::string &operation, const auto &run) {
+            const std::size_t before = allocations.load();
+            run();
+            const std::size_t count = allocations.load() - before;
+
+            bench.run(operation, run);
+            const double seconds = bench.results().back().median(ankerl::nanobench::Result::Measure::elapsed);
+            summary.push_back({ set.name, operation, double(json.size()) / seconds / 1e6,
+                                double(features) / seconds, double(count) / double(features) });
+        };
+
+        measure("parse<geojson>", [&] { ankerl::nanobench::doNotOptimizeAway(parse<geojson>(json)); });
+        measure("parse<geojson>(geometry_only)", [&] {
+            ankerl::nanobench::doNotOptimizeAway(parse<geojson>(json, parse_options::geometry_only()));
+        });
+        measure("parse<geojson>(properties_only)", [&] {
+            ankerl::nanobench::doNotOptimizeAway(parse<geojson>(json, parse_options::properties_only()));
+        });
+        measure("interned::parse<geojson>", [&] {
+            string_table strings;
+            ankerl::nanobench::doNotOptimizeAway(interned::parse(json, strings));
+        });
+        measure("parse_columnar", [&] { ankerl::nanobench::doNotOptimizeAway(parse_columnar(json)); });
+        measure("convert<geojson>(rapidjson_value)",
+                [&] { ankerl::nanobench::doNotOptimizeAway(convert<geojson>(document)); });
+        measure("convert<geojson>(value)", [&] { ankerl::nanobench::doNotOptimizeAway(convert<geojson>(dataValue)); });
+        measure("stringify<geojson>", [&] { ankerl::nanobench::doNotOptimizeAway(stringify<geojson>(data)); });
+        measure("convert(geojson, allocator)", [&] {
+            rapidjson_allocator allocator;
+            ankerl::nanobench::doNotOptimizeAway(convert(data, allocator));
+        });
+    }
+
+    std::printf("\n| %-20s | %-34s | %10s | %12s | %12s |\n", "dataset", "operation", "MB/s", "features/s",
+                "allocs/feature");
+    std::printf("|%s|%s|%s|%s|%s|\n", std::string(22, '-').c_str(), std::string(36, '-').c_str(),
+                std::string(12, '-').c_str(), std::string(14, '-').c_str(), std::string(16, '-').c_str());
+    for (const auto &row : summary) {
+        std::printf("| %-20s | %-34s | %10.1f | %12.0f | %14.2f |\n", row.dataset.c_str(), row.operation.c_str(),
+                    row.megabytesPerSecond, row.featuresPerSecond, row.allocationsPerFeature);
+    }
+
+    return 0;
+}
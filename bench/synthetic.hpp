@@ -0,0 +1,174 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+namespace bench {
+
+// Linear congruential generator; unlike the <random> distributions its output is the same on every
+// platform, so generated datasets are comparable across machines.
+class lcg {
+public:
+    explicit lcg(std::uint64_t seed) : state(seed) {
+    }
+
+    double next(double min, double max) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return min + (max - min) * double(state >> 11) * 0x1.0p-53;
+    }
+
+private:
+    std::uint64_t state;
+};
+
+inline maplibre::geojson::point position(lcg &random) {
+    const double x = random.next(-180, 180);
+    return { x, random.next(-85, 85) };
+}
+
+// A closed ring of vertices around a random position.
+inline maplibre::geojson::linear_ring ring(lcg &random, std::size_t vertices) {
+    const double pi     = 3.14159265358979323846;
+    const auto center   = position(random);
+    const double radius = random.next(0.001, 0.01);
+
+    maplibre::geojson::linear_ring ring;
+    ring.reserve(vertices + 1);
+    for (std::size_t v = 0; v < vertices; ++v) {
+        const double angle = 2 * pi * double(v) / double(vertices);
+        ring.push_back({ center.x + radius * std::cos(angle), center.y + radius * std::sin(angle) });
+    }
+    ring.push_back(ring.front());
+    return ring;
+}
+
+// A random walk of vertices.
+inline maplibre::geojson::line_string line(lcg &random, std::size_t vertices) {
+    maplibre::geojson::line_string line{ position(random) };
+    line.reserve(vertices);
+    while (line.size() < vertices) {
+        const auto &last = line.back();
+        line.push_back({ last.x + random.next(-0.001, 0.001), last.y + random.next(-0.001, 0.001) });
+    }
+    return line;
+}
+
+// Features of the geometries, each with an id and a name.
+template <class Make>
+maplibre::geojson::feature_collection features(std::size_t count, const Make &make) {
+    using namespace maplibre::geojson;
+
+    feature_collection collection;
+    collection.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        feature f{ make() };
+        f.id = std::uint64_t(i);
+        f.properties.emplace("name", "feature " + std::to_string(i));
+        collection.push_back(std::move(f));
+    }
+    return collection;
+}
+
+// Closed polygons scattered over the world, each with a name, an integer and a double property.
+inline maplibre::geojson::feature_collection polygons(std::size_t count, std::size_t vertices) {
+    using namespace maplibre::geojson;
+
+    lcg random(count * 31 + vertices);
+
+    feature_collection collection;
+    collection.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        feature f{ polygon{ ring(random, vertices) } };
+        f.id = std::uint64_t(i);
+        f.properties.emplace("name", "feature " + std::to_string(i));
+        f.properties.emplace("population", std::uint64_t(random.next(0, 1e6)));
+        f.properties.emplace("area", random.next(0, 100));
+        collection.push_back(std::move(f));
+    }
+    return collection;
+}
+
+// Points with many short string properties, like OSM tags or address data.
+inline maplibre::geojson::feature_collection tagged(std::size_t count, std::size_t tags) {
+    using namespace maplibre::geojson;
+
+    static const char *const values[] = { "residential", "service", "yes", "asphalt", "primary", "no" };
+    lcg random(count * 17 + tags);
+
+    feature_collection collection;
+    collection.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        feature f{ position(random) };
+        f.id = std::uint64_t(i);
+        for (std::size_t t = 0; t < tags; ++t) {
+            const auto index = std::size_t(random.next(0, 6));
+            f.properties.emplace("tag:" + std::to_string(t), std::string(values[index]));
+        }
+        f.properties.emplace("addr:street", "Street " + std::to_string(i % 1000));
+        collection.push_back(std::move(f));
+    }
+    return collection;
+}
+
+inline maplibre::geojson::feature_collection points(std::size_t count) {
+    lcg random(count * 7);
+    return features(count, [&] { return position(random); });
+}
+
+inline maplibre::geojson::feature_collection multiPoints(std::size_t count, std::size_t points) {
+    lcg random(count * 11 + points);
+    return features(count, [&] {
+        const auto walk = line(random, points);
+        return maplibre::geojson::multi_point(walk.begin(), walk.end());
+    });
+}
+
+inline maplibre::geojson::feature_collection lineStrings(std::size_t count, std::size_t vertices) {
+    lcg random(count * 13 + vertices);
+    return features(count, [&] { return line(random, vertices); });
+}
+
+inline maplibre::geojson::feature_collection multiLineStrings(std::size_t count, std::size_t lines,
+                                                              std::size_t vertices) {
+    lcg random(count * 19 + lines * 5 + vertices);
+    return features(count, [&] {
+        maplibre::geojson::multi_line_string result;
+        for (std::size_t l = 0; l < lines; ++l)
+            result.push_back(line(random, vertices));
+        return result;
+    });
+}
+
+// Polygons with holes, grouped into multipolygons.
+inline maplibre::geojson::feature_collection multiPolygons(std::size_t count, std::size_t polygons,
+                                                           std::size_t vertices) {
+    lcg random(count * 23 + polygons * 5 + vertices);
+    return features(count, [&] {
+        maplibre::geojson::multi_polygon result;
+        for (std::size_t p = 0; p < polygons; ++p)
+            result.push_back({ ring(random, vertices), ring(random, vertices / 2 + 3) });
+        return result;
+    });
+}
+
+// GeometryCollections nested depth levels deep, each level holding a point and a line string next to
+// the next level.
+inline maplibre::geojson::feature_collection geometryCollections(std::size_t count, std::size_t depth) {
+    using namespace maplibre::geojson;
+
+    lcg random(count * 29 + depth);
+    return features(count, [&] {
+        geometry_collection collection{ position(random), line(random, 4) };
+        for (std::size_t level = 1; level < depth; ++level) {
+            geometry_collection outer{ position(random), line(random, 4) };
+            outer.push_back(geometry{ std::move(collection) });
+            collection = std::move(outer);
+        }
+        return collection;
+    });
+}
+
+} // namespace bench
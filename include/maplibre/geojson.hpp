@@ -3,7 +3,17 @@
 #include <maplibre/feature.hpp>
 #include <maplibre/geometry.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
 #include <variant>
+#include <vector>
 
 namespace maplibre {
 namespace geojson {
@@ -25,23 +35,183 @@ using identifier         = maplibre::feature::identifier;
 using feature            = maplibre::feature::feature<double>;
 using feature_collection = maplibre::feature::feature_collection<double>;
 
-using geojson = std::variant<geometry, feature, feature_collection>;
+template <class CoordT>
+using basic_geojson = std::variant<maplibre::geometry::geometry<CoordT>,
+                                   maplibre::feature::feature<CoordT>,
+                                   maplibre::feature::feature_collection<CoordT>>;
+
+using geojson = basic_geojson<double>;
+
+// The coordinate type of a geometry, feature, feature_collection, or basic_geojson.
+template <class T>
+struct coordinate_type;
+
+template <class CoordT>
+struct coordinate_type<maplibre::geometry::geometry<CoordT>> {
+    using type = CoordT;
+};
+
+template <class CoordT>
+struct coordinate_type<maplibre::feature::feature<CoordT>> {
+    using type = CoordT;
+};
+
+template <class CoordT>
+struct coordinate_type<maplibre::feature::feature_collection<CoordT>> {
+    using type = CoordT;
+};
+
+template <class CoordT>
+struct coordinate_type<basic_geojson<CoordT>> {
+    using type = CoordT;
+};
+
+template <class T>
+using coordinate_type_t = typename coordinate_type<T>::type;
+
+// Converts a position, read as x and y, to a point of the coordinate type parsed into, e.g. to project
+// and quantize longitude and latitude to integer tile coordinates.
+template <class CoordT>
+using coordinate_transform = std::function<maplibre::geometry::point<CoordT>(double, double)>;
 
 // Parse inputs of known types. Instantiations are provided for geojson, geometry, feature, and
-// feature_collection.
+// feature_collection, and for their float, std::int32_t, and std::int16_t coordinate counterparts
+// (basic_geojson<CoordT>, geometry::geometry<CoordT>, ...). The input is read in place and doesn't need
+// to be NUL terminated.
+//
+// Positions are converted while each geometry is read, so no double-precision copy of the result is
+// made. Without a transform, coordinates are rounded to the nearest value of the coordinate type, and
+// integer coordinates out of its range are an error.
 template <class T>
-T parse(const std::string &);
+T parse(std::string_view, const coordinate_transform<coordinate_type_t<T>> & = {});
+
+template <class T>
+T parse(const char *, std::size_t, const coordinate_transform<coordinate_type_t<T>> & = {});
 
 // Parse any GeoJSON type.
-geojson parse(const std::string &);
+geojson parse(std::string_view);
+geojson parse(const char *, std::size_t);
+
+// The number of readable bytes past the end of the input that lets parse_padded() read it in place.
+constexpr std::size_t parse_padding = 64;
+
+// Parse input of which capacity bytes are readable from its start, like a std::string with its
+// capacity(). With at least parse_padding bytes past the end, the simdjson backend reads the input in
+// place instead of copying it first; otherwise this is the same as parse(). Instantiations are provided
+// for geojson, geometry, feature, and feature_collection.
+template <class T>
+T parse_padded(std::string_view, std::size_t capacity);
+
+// Parse padded input of any GeoJSON type.
+geojson parse_padded(std::string_view, std::size_t capacity);
+
+enum class property_mode : std::uint8_t {
+    all,   // keep every property
+    allow, // keep only the listed keys
+    deny,  // keep every property but the listed keys
+    none,  // drop properties entirely
+};
+
+// Selects the properties of features that are read. The values of the others are passed over without
+// being converted, so nothing is allocated for them. Filtering doesn't change which inputs are valid.
+struct property_filter {
+    property_mode mode = property_mode::all;
+    std::vector<std::string> keys;
+
+    bool keeps(std::string_view key) const {
+        switch (mode) {
+        case property_mode::all:
+            return true;
+        case property_mode::none:
+            return false;
+        default:
+            return (std::find(keys.begin(), keys.end(), key) != keys.end()) == (mode == property_mode::allow);
+        }
+    }
+};
+
+struct parse_options {
+    property_filter properties;
+    // Whether to read the geometries of features. Skipped ones are passed over by the tokenizer without
+    // being validated beyond JSON syntax, and the features get empty geometries.
+    bool geometries = true;
+
+    // Reads only the geometries and ids of features, e.g. for spatial indexing.
+    static parse_options geometry_only() {
+        return { { property_mode::none, {} }, true };
+    }
+
+    // Reads only the ids and properties of features, e.g. for attribute analytics.
+    static parse_options properties_only() {
+        return { {}, false };
+    }
+};
+
+// Parse inputs of known types with options. Instantiations are provided for the same types as parse.
+template <class T>
+T parse(std::string_view, const parse_options &, const coordinate_transform<coordinate_type_t<T>> & = {});
+
+// Parse any GeoJSON type with options.
+geojson parse(std::string_view, const parse_options &);
+
+// Parse a mutable buffer in place. Strings are unescaped within the buffer instead of being copied by
+// the tokenizer, and the buffer contents are unspecified afterwards. Instantiations are provided for
+// geojson, geometry, feature, and feature_collection.
+template <class T>
+T parse_insitu(char *, std::size_t);
+
+// Parse any GeoJSON type in place.
+geojson parse_insitu(char *, std::size_t);
+
+// Parse a file, memory-mapped read-only and parsed from the page cache without a copy, or read into
+// memory if it can't be mapped, like a pipe. Instantiations are provided for geojson, geometry, feature,
+// and feature_collection.
+template <class T>
+T parse_file(const std::filesystem::path &);
+
+// Parse a file of any GeoJSON type.
+geojson parse_file(const std::filesystem::path &);
+
+using feature_callback = std::function<void(feature &&)>;
+
+// Read a FeatureCollection and pass each feature to the callback as soon as it has been read, instead of
+// collecting them, so that memory use is bounded by the largest feature rather than the input size.
+// Throws the first invalid feature right away, and after reading if the input isn't a FeatureCollection.
+void for_each_feature(std::string_view, const feature_callback &);
+void for_each_feature(std::istream &, const feature_callback &);
+void for_each_feature(std::FILE *, const feature_callback &);
+
+struct stringify_options {
+    // Round coordinates to at most this many decimals (0-15), written by a fixed-precision formatter
+    // instead of shortest round-trip formatting. 6 decimals are about 10 cm in WGS84. Negative keeps
+    // full precision.
+    int max_decimals = -1;
+    // Write a "bbox" member, computed while the coordinates are written, on FeatureCollections, Features,
+    // and a geometry stringified on its own. Objects without coordinates get none.
+    bool bbox = false;
+};
 
 // Stringify inputs of known types. Instantiations are provided for geojson, geometry, feature, and
 // feature_collection.
 template <class T>
-std::string stringify(const T &);
+std::string stringify(const T &, const stringify_options & = {});
 
 // Stringify any GeoJSON type.
-std::string stringify(const geojson &);
+std::string stringify(const geojson &, const stringify_options & = {});
+
+using write_callback = std::function<void(const char *, std::size_t)>;
+
+// Stringify inputs of known types to a sink, in chunks of bounded size, so the output is never held in
+// memory as a whole. Produces the same output as stringify. Instantiations are provided for geojson,
+// geometry, feature, and feature_collection.
+template <class T>
+void write(const T &, const write_callback &, const stringify_options & = {});
+
+template <class T>
+void write(const T &, std::ostream &, const stringify_options & = {});
+
+template <class T>
+void write(const T &, std::FILE *, const stringify_options & = {});
 
 } // namespace geojson
 } // namespace maplibre
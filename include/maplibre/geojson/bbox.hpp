@@ -0,0 +1,79 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geometry/box.hpp>
+
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace maplibre {
+namespace geojson {
+
+using box = maplibre::geometry::box<double>;
+
+// Grows to enclose the positions and boxes added to it.
+class extent {
+public:
+    void extend(double x, double y) {
+        minX = x < minX ? x : minX;
+        minY = y < minY ? y : minY;
+        maxX = x > maxX ? x : maxX;
+        maxY = y > maxY ? y : maxY;
+    }
+
+    void extend(const std::optional<box> &other) {
+        if (other) {
+            extend(other->min.x, other->min.y);
+            extend(other->max.x, other->max.y);
+        }
+    }
+
+    // None until something was added.
+    std::optional<box> bounds() const {
+        if (minX > maxX)
+            return std::nullopt;
+        return box({ minX, minY }, { maxX, maxY });
+    }
+
+private:
+    double minX = std::numeric_limits<double>::infinity();
+    double minY = std::numeric_limits<double>::infinity();
+    double maxX = -std::numeric_limits<double>::infinity();
+    double maxY = -std::numeric_limits<double>::infinity();
+};
+
+// The bounding boxes of a parse result, in the coordinates of the input rather than those of a transform.
+// Each is the "bbox" member of its object where there is one, of which only the two horizontal
+// dimensions are kept, and is computed from the object's coordinates while they are read otherwise.
+// Objects without coordinates, like features with a null geometry, have none.
+struct bounding_boxes {
+    // Of the geometry, feature, or FeatureCollection parsed.
+    std::optional<box> root;
+    // Of each feature of a FeatureCollection, in order.
+    std::vector<std::optional<box>> features;
+};
+
+template <class T>
+struct parse_with_bboxes_result {
+    T result;
+    bounding_boxes bboxes;
+};
+
+// Parse like parse() does, and also report bounding boxes. Instantiations are provided for geojson,
+// geometry, feature, and feature_collection.
+template <class T>
+parse_with_bboxes_result<T> parse_with_bboxes(std::string_view, const parse_options & = {});
+
+// Parse any GeoJSON type with bounding boxes.
+parse_with_bboxes_result<geojson> parse_with_bboxes(std::string_view, const parse_options & = {});
+
+// The bounding box of the coordinates of parsed types, computed by visiting each of them. None for an
+// empty geometry or a collection without coordinates.
+std::optional<box> bounding_box(const geometry &);
+std::optional<box> bounding_box(const feature &);
+std::optional<box> bounding_box(const feature_collection &);
+
+} // namespace geojson
+} // namespace maplibre
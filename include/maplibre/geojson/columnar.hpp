@@ -0,0 +1,166 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace maplibre {
+namespace geojson {
+
+// The alternative a geometry holds, in the order of the geometry variant.
+enum class geometry_type : std::uint8_t {
+    empty,
+    point,
+    line_string,
+    polygon,
+    multi_point,
+    multi_line_string,
+    multi_polygon,
+    geometry_collection,
+};
+
+// A FeatureCollection stored column by column instead of as a vector of features: the positions of all
+// geometries in one buffer, offset arrays into it for the rings, parts and geometries, a type byte per
+// geometry, and property keys encoded as indices into a dictionary of the distinct keys. A feature then
+// costs a few offsets rather than a variant, nested vectors and a hash map of its own.
+//
+// Geometries are stored as rows of parts of rings of positions. Points, MultiPoints, LineStrings,
+// MultiLineStrings and Polygons have one part, of one ring for the first three; a MultiPolygon has a part
+// per polygon. A GeometryCollection has an empty part per member, and its members are the rows that
+// follow it. Offsets are 32-bit, so a collection holds fewer than 2^32 positions, rings, parts, geometries
+// and properties.
+class columnar_feature_collection {
+public:
+    // A geometry of the collection, read in place. Valid while the collection isn't modified.
+    class geometry_view {
+    public:
+        geometry_type type() const;
+
+        // Every position of the geometry, including those of all its parts and members, in order.
+        std::span<const point> points() const;
+
+        // The polygons of a MultiPolygon, the members of a GeometryCollection, none for an empty geometry,
+        // and one part otherwise.
+        std::size_t size() const;
+
+        // The rings of a part: the rings of a polygon, the lines of a MultiLineString, or the one ring of
+        // the positions of a Point, MultiPoint or LineString.
+        std::size_t rings(std::size_t part) const;
+        std::span<const point> ring(std::size_t part, std::size_t ring) const;
+
+        // A member of a GeometryCollection.
+        geometry_view member(std::size_t) const;
+
+        // Copies the geometry.
+        explicit operator maplibre::geojson::geometry() const;
+
+    private:
+        friend class columnar_feature_collection;
+
+        geometry_view(const columnar_feature_collection &, std::uint32_t row);
+
+        std::uint32_t firstRing(std::size_t part) const;
+
+        const columnar_feature_collection *collection;
+        std::uint32_t row;
+    };
+
+    // A feature of the collection, read in place. Valid while the collection isn't modified.
+    class feature_view {
+    public:
+        geometry_view geometry() const;
+        const identifier &id() const;
+
+        // The properties, in the order they were added.
+        std::size_t property_count() const;
+        std::string_view key_at(std::size_t) const;
+        const value &value_at(std::size_t) const;
+
+        // The value of a property, or nullptr if there is none.
+        const value *find(std::string_view key) const;
+
+        // Copies the feature.
+        explicit operator feature() const;
+
+    private:
+        friend class columnar_feature_collection;
+
+        feature_view(const columnar_feature_collection &, std::size_t index);
+
+        const columnar_feature_collection *collection;
+        std::size_t index;
+    };
+
+    columnar_feature_collection();
+    explicit columnar_feature_collection(const feature_collection &);
+
+    // Appends a copy of a feature. Throws error when an offset would overflow.
+    void push_back(const feature &);
+
+    // Appends a feature, moving its property values and id in. The collection is left as it was when this
+    // throws, but the feature may have been moved from.
+    void push_back(feature &&);
+
+    std::size_t size() const;
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // The feature at an index less than size().
+    feature_view operator[](std::size_t) const;
+
+    // The buffer of all positions, and the distinct property keys.
+    std::span<const point> points() const;
+    const std::vector<std::string> &keys() const;
+
+    // Copies the features.
+    explicit operator feature_collection() const;
+
+private:
+    struct key_hash {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view key) const {
+            return std::hash<std::string_view>()(key);
+        }
+    };
+
+    template <class Feature>
+    void append(Feature &&);
+    void appendGeometry(const maplibre::geojson::geometry &);
+    void appendRing(const point *, std::size_t size);
+    void closePart();
+    std::uint32_t keyIndex(const std::string &);
+    std::uint32_t subtreeEnd(std::uint32_t row) const;
+
+    std::vector<point> coordinates;
+    std::vector<std::uint32_t> ringOffsets;     // into coordinates, one more than there are rings
+    std::vector<std::uint32_t> partOffsets;     // into ringOffsets, one more than there are parts
+    std::vector<std::uint32_t> geometryOffsets; // into partOffsets, one more than there are geometry rows
+    std::vector<geometry_type> geometryTypes;
+    std::vector<std::uint32_t> featureGeometries; // the row of each feature's geometry
+
+    // Empty as long as every id is null.
+    std::vector<identifier> ids;
+
+    std::vector<std::uint32_t> propertyOffsets; // into propertyKeys, one more than there are features
+    std::vector<std::uint32_t> propertyKeys;    // into keyNames
+    std::vector<value> propertyValues;
+    std::vector<std::string> keyNames;
+    std::unordered_map<std::string, std::uint32_t, key_hash, std::equal_to<>> keyIndices;
+};
+
+// Parse a FeatureCollection into columns. Features are appended as soon as they are read, so no
+// feature_collection is built along the way. Throws like for_each_feature() does.
+columnar_feature_collection parse_columnar(std::string_view, const parse_options & = {});
+
+} // namespace geojson
+} // namespace maplibre
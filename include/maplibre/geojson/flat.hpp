@@ -0,0 +1,283 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace maplibre {
+namespace geojson {
+namespace flat {
+
+// Properties kept in one array sorted by key and found by binary search, instead of in a hash map with a
+// node per property. Up to N of them are stored within the map itself, so that features with few
+// properties need no allocation for them. Lookups behave like those of the unordered_map prop_map: the
+// first of duplicate keys is kept, find() returns end() and at() throws std::out_of_range for a missing
+// key, and two maps are equal when they hold the same members. Members are iterated in key order.
+template <std::size_t N>
+class basic_property_map {
+public:
+    using key_type       = std::string;
+    using mapped_type    = maplibre::geojson::value;
+    using value_type     = std::pair<std::string, mapped_type>;
+    using size_type      = std::size_t;
+    using iterator       = const value_type *;
+    using const_iterator = const value_type *;
+
+    static constexpr size_type inline_capacity = N;
+
+    basic_property_map() noexcept = default;
+
+    basic_property_map(std::initializer_list<value_type> members) {
+        reserve(members.size());
+        for (const auto &member : members) {
+            emplace(member.first, member.second);
+        }
+    }
+
+    explicit basic_property_map(const maplibre::geojson::value::object_type &members) {
+        reserve(members.size());
+        for (const auto &member : members) {
+            emplace(member.first, member.second);
+        }
+    }
+
+    basic_property_map(const basic_property_map &other) {
+        try {
+            reserve(other.size());
+            std::uninitialized_copy(other.begin(), other.end(), data());
+        } catch (...) {
+            release();
+            throw;
+        }
+        used = other.used;
+    }
+
+    basic_property_map(basic_property_map &&other) noexcept {
+        take(other);
+    }
+
+    basic_property_map &operator=(const basic_property_map &other) {
+        if (this != &other) {
+            basic_property_map copy(other);
+            release();
+            take(copy);
+        }
+        return *this;
+    }
+
+    basic_property_map &operator=(basic_property_map &&other) noexcept {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~basic_property_map() {
+        release();
+    }
+
+    explicit operator maplibre::geojson::value::object_type() const {
+        maplibre::geojson::value::object_type result;
+        result.reserve(size());
+        for (const auto &member : *this) {
+            result.emplace(member.first, member.second);
+        }
+        return result;
+    }
+
+    size_type size() const {
+        return used;
+    }
+
+    bool empty() const {
+        return used == 0;
+    }
+
+    size_type capacity() const {
+        return allocated;
+    }
+
+    const_iterator begin() const {
+        return data();
+    }
+
+    const_iterator end() const {
+        return data() + used;
+    }
+
+    const_iterator find(std::string_view key) const {
+        const value_type *member = lowerBound(key);
+        return member != end() && member->first == key ? member : end();
+    }
+
+    size_type count(std::string_view key) const {
+        return find(key) != end() ? 1 : 0;
+    }
+
+    bool contains(std::string_view key) const {
+        return find(key) != end();
+    }
+
+    mapped_type &at(std::string_view key) {
+        return const_cast<mapped_type &>(std::as_const(*this).at(key));
+    }
+
+    const mapped_type &at(std::string_view key) const {
+        const auto member = find(key);
+        if (member == end())
+            throw std::out_of_range("property_map::at");
+        return member->second;
+    }
+
+    // The value of a key, inserting a null value if there is none.
+    mapped_type &operator[](std::string_view key) {
+        return insert(key, [&] { return value_type(std::string(key), mapped_type()); }).first->second;
+    }
+
+    // Inserts a member unless there already is one with the key.
+    template <class Key, class Value>
+    std::pair<const_iterator, bool> emplace(Key &&key, Value &&element) {
+        const std::string_view name(key);
+        return insert(name, [&] { return value_type(std::forward<Key>(key), std::forward<Value>(element)); });
+    }
+
+    size_type erase(std::string_view key) {
+        value_type *member = const_cast<value_type *>(find(key));
+        if (member == end())
+            return 0;
+        std::move(member + 1, data() + used, member);
+        data()[--used].~value_type();
+        return 1;
+    }
+
+    void reserve(size_type size) {
+        if (size > allocated)
+            reallocate(size);
+    }
+
+    void clear() noexcept {
+        std::destroy(data(), data() + used);
+        used = 0;
+    }
+
+    friend bool operator==(const basic_property_map &a, const basic_property_map &b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    friend bool operator!=(const basic_property_map &a, const basic_property_map &b) {
+        return !(a == b);
+    }
+
+private:
+    value_type *data() {
+        return heap ? heap : reinterpret_cast<value_type *>(buffer);
+    }
+
+    const value_type *data() const {
+        return heap ? heap : reinterpret_cast<const value_type *>(buffer);
+    }
+
+    const value_type *lowerBound(std::string_view key) const {
+        return std::lower_bound(begin(), end(), key,
+                                [](const value_type &member, std::string_view name) { return member.first < name; });
+    }
+
+    template <class Make>
+    std::pair<value_type *, bool> insert(std::string_view key, const Make &make) {
+        const std::size_t index = static_cast<std::size_t>(lowerBound(key) - begin());
+        if (index < used && data()[index].first == key)
+            return { data() + index, false };
+
+        value_type member = make();
+        if (used == allocated)
+            reallocate(std::max<size_type>(allocated * 2, 4));
+
+        value_type *members = data();
+        if (index == used) {
+            ::new (members + used) value_type(std::move(member));
+        } else {
+            ::new (members + used) value_type(std::move(members[used - 1]));
+            std::move_backward(members + index, members + used - 1, members + used);
+            members[index] = std::move(member);
+        }
+        ++used;
+        return { members + index, true };
+    }
+
+    void reallocate(size_type size) {
+        value_type *members = std::allocator<value_type>().allocate(size);
+        std::uninitialized_move(data(), data() + used, members);
+        std::destroy(data(), data() + used);
+        if (heap)
+            std::allocator<value_type>().deallocate(heap, allocated);
+        heap      = members;
+        allocated = static_cast<std::uint32_t>(size);
+    }
+
+    // Takes the members of other, which is left empty, while this map is empty and has no allocation.
+    void take(basic_property_map &other) noexcept {
+        if (other.heap) {
+            heap      = std::exchange(other.heap, nullptr);
+            allocated = std::exchange(other.allocated, std::uint32_t(N));
+        } else {
+            std::uninitialized_move(other.data(), other.data() + other.used, data());
+            std::destroy(other.data(), other.data() + other.used);
+        }
+        used = std::exchange(other.used, 0);
+    }
+
+    void release() noexcept {
+        clear();
+        if (heap)
+            std::allocator<value_type>().deallocate(heap, allocated);
+        heap      = nullptr;
+        allocated = N;
+    }
+
+    value_type *heap        = nullptr;
+    std::uint32_t used      = 0;
+    std::uint32_t allocated = N;
+    alignas(value_type) unsigned char buffer[N ? N * sizeof(value_type) : 1];
+};
+
+// Two members are stored inline, which covers many features of typical datasets without an allocation.
+// An empty map is larger than an empty unordered_map, but one with a member or more takes less memory;
+// bench/properties.cpp measures both.
+using property_map = basic_property_map<2>;
+
+// The usual GeoJSON types, with properties in a property_map.
+struct feature {
+    maplibre::geojson::geometry geometry;
+    property_map properties;
+    identifier id;
+};
+
+struct feature_collection : std::vector<feature> {
+    using std::vector<feature>::vector;
+};
+
+using geojson = std::variant<maplibre::geojson::geometry, feature, feature_collection>;
+
+// Parse inputs of known types like maplibre::geojson::parse() does. Instantiations are provided for
+// geojson, feature, and feature_collection.
+template <class T>
+T parse(std::string_view, const parse_options & = {});
+
+// Parse any GeoJSON type.
+geojson parse(std::string_view, const parse_options & = {});
+
+} // namespace flat
+} // namespace geojson
+} // namespace maplibre
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/bbox.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace maplibre {
+namespace geojson {
+
+struct index_options {
+    // Build on this many threads, 0 for one per hardware thread. The index doesn't depend on the number
+    // of threads.
+    unsigned threads = 1;
+    // Children per node (2-65535). Larger nodes make smaller indexes that are slower to query.
+    std::uint16_t node_size = 16;
+};
+
+// A static R-tree over the bounding boxes of features, packed like flatbush: the boxes are sorted along a
+// Hilbert curve through their centers and grouped bottom-up into full nodes, so the tree is stored in
+// two flat arrays and built without any node splits.
+class feature_index {
+public:
+    // An index of nothing.
+    feature_index();
+
+    // Indexes the features with a box, such as those a parse_with_bboxes() call reported.
+    explicit feature_index(const std::vector<std::optional<box>> &, const index_options & = {});
+    explicit feature_index(const bounding_boxes &, const index_options & = {});
+
+    // Indexes the features of a collection by the bounding boxes of their coordinates.
+    explicit feature_index(const feature_collection &, const index_options & = {});
+
+    // The number of features the index was built for, including those without a box.
+    std::size_t size() const;
+
+    // The indices of the features whose box intersects the given one, boundaries included, in ascending
+    // order.
+    std::vector<std::size_t> query(const box &) const;
+
+    // A binary copy of the index, with numbers in little-endian byte order, to be cached with its source.
+    std::string serialize() const;
+
+    // Reads a copy made by serialize(). Throws error for data that isn't one.
+    static feature_index deserialize(std::string_view);
+
+private:
+    void build(const std::vector<std::optional<box>> &, const index_options &);
+    std::size_t upperBound(std::size_t node) const;
+
+    std::size_t features = 0;
+    std::size_t items    = 0; // features with a box
+    std::uint16_t nodeSize = 16;
+    // minX, minY, maxX, and maxY of the leaves, in Hilbert order, followed by those of each level of
+    // nodes above them, up to the root.
+    std::vector<double> boxes;
+    // For each leaf its feature, and for each node the offset in boxes of its first child.
+    std::vector<std::uint32_t> indices;
+    // The offset in boxes where each level ends.
+    std::vector<std::size_t> levelBounds;
+};
+
+} // namespace geojson
+} // namespace maplibre
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/members.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace maplibre {
+namespace geojson {
+
+// Strings stored for the results of interned parses to refer to, in blocks that never move. Keys are
+// stored once however many features have them. Values up to a length are too, since short values like
+// "residential" tend to repeat; longer ones are stored as they are, without the cost of looking them up.
+class string_table {
+public:
+    // Values longer than max_shared_value bytes aren't shared. 0 shares no values.
+    explicit string_table(std::size_t max_shared_value = 32);
+
+    string_table(string_table &&) noexcept;
+    string_table &operator=(string_table &&) noexcept;
+    ~string_table();
+
+    // The stored copy of a key or value.
+    std::string_view key(std::string_view);
+    std::string_view value(std::string_view);
+
+    // The number of strings stored, and their total length.
+    std::size_t size() const;
+    std::size_t bytes() const;
+
+private:
+    std::string_view store(std::string_view);
+    std::string_view share(std::string_view);
+
+    std::size_t maxSharedValue;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char *next            = nullptr;
+    std::size_t available = 0;
+    std::unordered_set<std::string_view> shared;
+    std::size_t count  = 0;
+    std::size_t length = 0;
+};
+
+namespace interned {
+
+// GeoJSON types whose property keys, string values and string ids are views of a string_table, which
+// must outlive them. Geometries are the usual ones.
+
+using null_value_t = maplibre::feature::null_value_t;
+
+struct value;
+
+using value_base = std::variant<null_value_t,
+                                bool,
+                                std::uint64_t,
+                                std::int64_t,
+                                double,
+                                std::string_view,
+                                std::vector<value>,
+                                std::vector<std::pair<std::string_view, value>>>;
+
+// Objects keep their members in document order, without duplicate keys.
+struct value : value_base {
+    using array_type  = std::vector<value>;
+    using object_type = std::vector<std::pair<std::string_view, value>>;
+
+    using value_base::value_base;
+};
+
+using prop_map   = value::object_type;
+using identifier = std::variant<null_value_t, std::uint64_t, std::int64_t, double, std::string_view>;
+
+struct feature {
+    maplibre::geojson::geometry geometry;
+    prop_map properties;
+    identifier id;
+};
+
+struct feature_collection : std::vector<feature> {
+    using std::vector<feature>::vector;
+};
+
+using geojson = std::variant<maplibre::geojson::geometry, feature, feature_collection>;
+
+// Finds a member of an object by a linear search. Returns nullptr if there is none.
+inline const value *find(const prop_map &properties, std::string_view key) {
+    return findMember(properties, key);
+}
+
+// Parse inputs of known types like maplibre::geojson::parse() does, storing their strings in the table.
+// Instantiations are provided for geojson, feature, and feature_collection.
+template <class T>
+T parse(std::string_view, string_table &, const parse_options & = {});
+
+// Parse any GeoJSON type.
+geojson parse(std::string_view, string_table &, const parse_options & = {});
+
+// Parse a mutable buffer in place like maplibre::geojson::parse_insitu() does, without a string table:
+// keys and strings are unescaped within the buffer and the result refers to them there, so that none is
+// copied. The buffer must outlive the result. Instantiations are provided for geojson, feature, and
+// feature_collection.
+template <class T>
+T parse_insitu(char *, std::size_t, const parse_options & = {});
+
+// Parse any GeoJSON type in place.
+geojson parse_insitu(char *, std::size_t, const parse_options & = {});
+
+// Convert Value to known types like maplibre::geojson::convert() does, storing their strings in the
+// table. Instantiations are provided for geojson, feature, and feature_collection.
+template <class T>
+T convert(const maplibre::geojson::value &, string_table &, const parse_options & = {});
+
+// Converts Value to GeoJSON type.
+geojson convert(const maplibre::geojson::value &, string_table &, const parse_options & = {});
+
+} // namespace interned
+
+} // namespace geojson
+} // namespace maplibre
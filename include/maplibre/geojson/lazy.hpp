@@ -0,0 +1,83 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/rapidjson.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace maplibre {
+namespace geojson {
+
+// A FeatureCollection kept as a rapidjson document, whose features are converted when they are first
+// accessed, either whole or only their geometry, properties or id, and cached. Looking at a few features
+// of a large collection then costs the tokenizing and those conversions only.
+//
+// Only the collection itself is validated up front; an invalid feature throws what convert<feature>()
+// would when it is accessed. Accessors are const but fill the cache, so a collection must not be
+// accessed from several threads at once.
+class lazy_feature_collection {
+public:
+    // Parses a FeatureCollection, or a bare array of features like parse<feature_collection>(). Throws
+    // syntax errors like parse() does.
+    explicit lazy_feature_collection(std::string_view);
+
+    // Takes a parsed document holding a FeatureCollection or an array of features.
+    explicit lazy_feature_collection(rapidjson_document &&);
+
+    lazy_feature_collection(lazy_feature_collection &&) noexcept;
+    lazy_feature_collection &operator=(lazy_feature_collection &&) noexcept;
+    ~lazy_feature_collection();
+
+    std::size_t size() const;
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // The feature at an index less than size().
+    const feature &operator[](std::size_t) const;
+
+    // The feature at an index, throwing std::out_of_range past the end.
+    const feature &at(std::size_t) const;
+
+    // Parts of the feature at an index less than size(), converting only that part.
+    const maplibre::geojson::geometry &geometry_at(std::size_t) const;
+    const maplibre::feature::property_map &properties_at(std::size_t) const;
+    const identifier &id_at(std::size_t) const;
+
+    // The index of the first feature with the id, converting the ids only, or nullopt if there is none.
+    // Features are not validated, so invalid ones don't throw; only their ids are compared. Features
+    // without an id are never found, not even by a null id.
+    std::optional<std::size_t> find(const identifier &) const;
+
+    // Copies the features cached whole, and converts the others without caching them.
+    explicit operator feature_collection() const;
+
+private:
+    enum part : std::uint8_t {
+        geometryPart   = 1,
+        propertiesPart = 2,
+        idPart         = 4,
+    };
+
+    struct entry {
+        feature value;
+        std::uint8_t parts = 0;
+    };
+
+    void index();
+    const rapidjson_value &element(std::size_t) const;
+    entry &load(std::size_t, std::uint8_t parts) const;
+
+    std::unique_ptr<rapidjson_document> document;
+    const rapidjson_value *features = nullptr;
+    mutable std::vector<std::unique_ptr<entry>> cache;
+};
+
+} // namespace geojson
+} // namespace maplibre
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+namespace maplibre {
+namespace geojson {
+
+// Helpers for objects stored as vectors of key and value pairs in document order, like the prop_maps of
+// the pmr and interned types.
+
+// Finds a member of an object by a linear search, which is faster than hashing for the few properties
+// features usually have. Returns nullptr if there is none.
+template <class Members>
+const typename Members::value_type::second_type *findMember(const Members &members, std::string_view key) {
+    for (const auto &member : members) {
+        if (std::string_view(member.first) == key)
+            return &member.second;
+    }
+    return nullptr;
+}
+
+// Removes the members of an object whose key an earlier member has, keeping the rest in document order.
+// Small objects are checked member by member; larger ones through an index sorted by key, so that wide
+// objects take O(n log n) rather than O(n²).
+template <class Members>
+void removeDuplicateKeys(Members &members) {
+    const auto key = [&](std::size_t index) { return std::string_view(members[index].first); };
+    std::vector<bool> duplicate(members.size());
+    bool found = false;
+    if (members.size() <= 16) {
+        for (std::size_t i = 1; i < members.size(); ++i) {
+            for (std::size_t j = 0; j < i && !duplicate[i]; ++j) {
+                duplicate[i] = key(i) == key(j);
+            }
+            found = found || duplicate[i];
+        }
+    } else {
+        std::vector<std::size_t> order(members.size());
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            const int compared = key(a).compare(key(b));
+            return compared < 0 || (compared == 0 && a < b);
+        });
+        for (std::size_t i = 1; i < order.size(); ++i) {
+            if (key(order[i]) == key(order[i - 1])) {
+                duplicate[order[i]] = true;
+                found               = true;
+            }
+        }
+    }
+    if (!found)
+        return;
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < members.size(); ++i) {
+        if (!duplicate[i]) {
+            if (kept != i)
+                members[kept] = std::move(members[i]);
+            ++kept;
+        }
+    }
+    members.erase(members.begin() + kept, members.end());
+}
+
+} // namespace geojson
+} // namespace maplibre
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/members.hpp>
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace maplibre {
+namespace geojson {
+namespace pmr {
+
+// GeoJSON types whose strings and containers use std::pmr allocators at every level of nesting, unlike
+// the maplibre::geometry and maplibre::feature containers, so that a whole parse result can live in one
+// memory resource.
+
+using empty = maplibre::geometry::empty;
+using point = maplibre::geometry::point<double>;
+
+struct multi_point : std::pmr::vector<point> {
+    using std::pmr::vector<point>::vector;
+};
+
+struct line_string : std::pmr::vector<point> {
+    using std::pmr::vector<point>::vector;
+};
+
+struct linear_ring : std::pmr::vector<point> {
+    using std::pmr::vector<point>::vector;
+};
+
+struct multi_line_string : std::pmr::vector<line_string> {
+    using std::pmr::vector<line_string>::vector;
+};
+
+struct polygon : std::pmr::vector<linear_ring> {
+    using std::pmr::vector<linear_ring>::vector;
+};
+
+struct multi_polygon : std::pmr::vector<polygon> {
+    using std::pmr::vector<polygon>::vector;
+};
+
+struct geometry;
+
+struct geometry_collection : std::pmr::vector<geometry> {
+    using std::pmr::vector<geometry>::vector;
+};
+
+using geometry_base = std::variant<empty,
+                                   point,
+                                   line_string,
+                                   polygon,
+                                   multi_point,
+                                   multi_line_string,
+                                   multi_polygon,
+                                   geometry_collection>;
+
+struct geometry : geometry_base {
+    using geometry_base::geometry_base;
+};
+
+using null_value_t = maplibre::feature::null_value_t;
+
+struct value;
+
+using value_base = std::variant<null_value_t,
+                                bool,
+                                std::uint64_t,
+                                std::int64_t,
+                                double,
+                                std::pmr::string,
+                                std::pmr::vector<value>,
+                                std::pmr::vector<std::pair<std::pmr::string, value>>>;
+
+// Arrays and objects are held directly rather than through shared pointers. Objects keep their members in
+// document order, without duplicate keys.
+struct value : value_base {
+    using array_type  = std::pmr::vector<value>;
+    using object_type = std::pmr::vector<std::pair<std::pmr::string, value>>;
+
+    using value_base::value_base;
+};
+
+using prop_map   = value::object_type;
+using identifier = std::variant<null_value_t, std::uint64_t, std::int64_t, double, std::pmr::string>;
+
+struct feature {
+    pmr::geometry geometry;
+    prop_map properties;
+    identifier id;
+};
+
+struct feature_collection : std::pmr::vector<feature> {
+    using std::pmr::vector<feature>::vector;
+};
+
+using geojson = std::variant<geometry, feature, feature_collection>;
+
+// Finds a member of an object by a linear search. Returns nullptr if there is none.
+inline const value *find(const prop_map &properties, std::string_view key) {
+    return findMember(properties, key);
+}
+
+// Parse inputs of known types, allocating every string and container of the result from the memory
+// resource, which must outlive the result. With a std::pmr::monotonic_buffer_resource, a parse makes a
+// handful of large allocations instead of one per container, node and string, and releasing the
+// resource frees the whole result at once. Instantiations are provided for geojson, geometry, feature,
+// and feature_collection.
+template <class T>
+T parse(std::string_view, std::pmr::memory_resource *);
+
+// Parse any GeoJSON type.
+geojson parse(std::string_view, std::pmr::memory_resource *);
+
+} // namespace pmr
+} // namespace geojson
+} // namespace maplibre
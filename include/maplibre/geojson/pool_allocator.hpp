@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+namespace maplibre {
+namespace geojson {
+
+// rapidjson allocator handing out blocks from a list of chunks, like rapidjson::MemoryPoolAllocator, so that
+// a document makes a few large allocations instead of one per value, member array and string. Memory is
+// only returned when the allocator is cleared or destroyed, which frees a whole document at once.
+//
+// Every block is aligned for any scalar type. MemoryPoolAllocator aligns blocks to the size of its chunk
+// header, which on 32-bit ARM leaves the 8-byte numbers in a GenericValue misaligned
+// (https://github.com/miloyip/rapidjson/issues/200, 301, 388); here the header is padded to the alignment.
+class pool_allocator {
+public:
+    static const bool kNeedFree = false;
+
+    static constexpr std::size_t defaultChunkCapacity = 64 * 1024;
+
+    explicit pool_allocator(std::size_t capacity = defaultChunkCapacity) : chunkCapacity(capacity) {
+    }
+
+    pool_allocator(const pool_allocator &)            = delete;
+    pool_allocator &operator=(const pool_allocator &) = delete;
+
+    ~pool_allocator() {
+        Clear();
+    }
+
+    void *Malloc(std::size_t size) {
+        if (!size)
+            return nullptr;
+
+        size = aligned(size);
+        if (!head || head->size + size > head->capacity)
+            addChunk(size);
+
+        void *block = data(head) + head->size;
+        head->size += size;
+        return block;
+    }
+
+    void *Realloc(void *original, std::size_t originalSize, std::size_t newSize) {
+        if (!original)
+            return Malloc(newSize);
+        if (!newSize)
+            return nullptr;
+
+        originalSize = aligned(originalSize);
+        newSize      = aligned(newSize);
+        if (originalSize >= newSize)
+            return original;
+
+        // The most recent block grows in place while its chunk has room.
+        if (static_cast<char *>(original) + originalSize == data(head) + head->size &&
+            head->size - originalSize + newSize <= head->capacity) {
+            head->size += newSize - originalSize;
+            return original;
+        }
+
+        void *block = Malloc(newSize);
+        std::memcpy(block, original, originalSize);
+        return block;
+    }
+
+    static void Free(void *) {
+    }
+
+    // Frees every block.
+    void Clear() {
+        while (head) {
+            chunk *next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+
+    // Total bytes of the chunks.
+    std::size_t Capacity() const {
+        std::size_t capacity = 0;
+        for (const chunk *c = head; c; c = c->next)
+            capacity += c->capacity;
+        return capacity;
+    }
+
+    // Number of chunks, each one heap allocation.
+    std::size_t ChunkCount() const {
+        std::size_t count = 0;
+        for (const chunk *c = head; c; c = c->next)
+            ++count;
+        return count;
+    }
+
+    // Bytes handed out, including alignment padding.
+    std::size_t Size() const {
+        std::size_t size = 0;
+        for (const chunk *c = head; c; c = c->next)
+            size += c->size;
+        return size;
+    }
+
+    static constexpr std::size_t alignment = alignof(std::max_align_t);
+
+private:
+    // Its size is a multiple of the alignment, so the data following it is aligned as well.
+    struct alignas(std::max_align_t) chunk {
+        std::size_t capacity;
+        std::size_t size;
+        chunk *next;
+    };
+
+    static std::size_t aligned(std::size_t size) {
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    static char *data(chunk *c) {
+        return reinterpret_cast<char *>(c) + sizeof(chunk);
+    }
+
+    void addChunk(std::size_t size) {
+        const std::size_t capacity = std::max(chunkCapacity, size);
+        head = new (::operator new(sizeof(chunk) + capacity)) chunk{ capacity, 0, head };
+    }
+
+    std::size_t chunkCapacity;
+    chunk *head = nullptr;
+};
+
+} // namespace geojson
+} // namespace maplibre
@@ -1,8 +1,12 @@
 #pragma once
 
 #include <maplibre/geojson.hpp>
+#include <maplibre/geojson/pool_allocator.hpp>
+
 #include <rapidjson/document.h>
 
+#include <string_view>
+
 namespace maplibre {
 namespace geojson {
 
@@ -12,6 +16,11 @@ using rapidjson_allocator = rapidjson::CrtAllocator;
 using rapidjson_document  = rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson_allocator>;
 using rapidjson_value     = rapidjson::GenericValue<rapidjson::UTF8<>, rapidjson_allocator>;
 
+// Opt-in documents whose values are allocated from a pool rather than one malloc each, and are only freed
+// together with the document; see pool_allocator for why this isn't rapidjson's MemoryPoolAllocator.
+using rapidjson_pool_document = rapidjson::GenericDocument<rapidjson::UTF8<>, pool_allocator>;
+using rapidjson_pool_value    = rapidjson::GenericValue<rapidjson::UTF8<>, pool_allocator>;
+
 // Convert inputs of known types. Instantiations are provided for geojson, geometry, feature, and
 // feature_collection.
 template <typename T>
@@ -20,6 +29,44 @@ T convert(const rapidjson_value &);
 // Convert any GeoJSON type.
 geojson convert(const rapidjson_value &);
 
+struct convert_options {
+    // Convert the features of a FeatureCollection on this many threads, 0 for one per hardware thread.
+    // The result and the error thrown for invalid input, that of the first invalid feature, don't depend
+    // on the number of threads.
+    unsigned threads = 1;
+    // Which properties of features to convert, and whether to convert their geometries, as for parse.
+    property_filter properties;
+    bool geometries = true;
+};
+
+// Convert inputs of known types with options. Instantiations are provided for geojson, geometry, feature,
+// and feature_collection.
+template <typename T>
+T convert(const rapidjson_value &, const convert_options &);
+
+// Convert any GeoJSON type with options.
+geojson convert(const rapidjson_value &, const convert_options &);
+
+// Convert the values of pool documents like those of rapidjson_document, with the same results and errors.
+// They are read on one thread whatever the options ask for. Instantiations are provided for geojson,
+// geometry, feature, and feature_collection.
+template <typename T>
+T convert(const rapidjson_pool_value &, const convert_options & = {});
+
+// Convert any GeoJSON type from a pool document.
+geojson convert(const rapidjson_pool_value &, const convert_options & = {});
+
+// Parse with rapidjson::Reader, which parse() uses unless built with GEOJSON_SIMDJSON. Instantiations are
+// provided for geojson, geometry, feature, and feature_collection.
+template <typename T>
+T parse_rapidjson(std::string_view, const coordinate_transform<coordinate_type_t<T>> & = {});
+template <typename T>
+T parse_rapidjson(std::string_view, const parse_options &, const coordinate_transform<coordinate_type_t<T>> & = {});
+
+// Parse any GeoJSON type with rapidjson::Reader.
+geojson parse_rapidjson(std::string_view);
+geojson parse_rapidjson(std::string_view, const parse_options &);
+
 // Convert back to rapidjson value. Instantiations are provided for geojson, geometry, feature, and
 // feature_collection.
 template <typename T>
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <string_view>
+
+namespace maplibre {
+namespace geojson {
+
+// Sequences of features, one JSON text each: GeoJSON text sequences (RFC 8142), where every text starts
+// with a record separator (0x1E) and ends with a line feed, and newline-delimited GeoJSON, one text per
+// line. Readers tell them apart by whether the input starts with a record separator, and skip blank
+// records.
+enum class seq_format {
+    newline_delimited,
+    rfc8142,
+};
+
+struct seq_options {
+    // Parse records on this many threads, 0 for one per hardware thread.
+    unsigned threads = 0;
+
+    // The input is split at the first record boundary after every multiple of this many bytes, and each
+    // chunk of records is parsed as a whole on one thread.
+    std::size_t chunk_size = 4 * 1024 * 1024;
+};
+
+// Reads the features of a sequence in input order, parsing the chunks ahead of the one being read on
+// up to options.threads threads. An invalid record is thrown when it is reached, with its byte offset.
+class seq_reader {
+public:
+    // Reads a sequence in memory, which must outlive the reader.
+    explicit seq_reader(std::string_view, const seq_options & = {});
+
+    // Reads a file, memory-mapped, or read into memory if it can't be mapped, like a pipe.
+    static seq_reader open(const std::filesystem::path &, const seq_options & = {});
+
+    seq_reader(seq_reader &&) noexcept;
+    seq_reader &operator=(seq_reader &&) noexcept;
+    ~seq_reader();
+
+    // Moves the next feature into result, or returns false at the end of the input.
+    bool next(feature &result);
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = feature;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = feature *;
+        using reference         = feature &;
+
+        iterator() = default;
+
+        reference operator*() {
+            return current;
+        }
+
+        pointer operator->() {
+            return &current;
+        }
+
+        iterator &operator++() {
+            if (!reader->next(current))
+                reader = nullptr;
+            return *this;
+        }
+
+        bool operator==(const iterator &other) const {
+            return reader == other.reader;
+        }
+
+        bool operator!=(const iterator &other) const {
+            return reader != other.reader;
+        }
+
+    private:
+        friend class seq_reader;
+
+        explicit iterator(seq_reader *owner) : reader(owner) {
+            ++*this;
+        }
+
+        seq_reader *reader = nullptr;
+        feature current;
+    };
+
+    // Input iterators over the remaining features; the reader can be iterated once.
+    iterator begin() {
+        return iterator(this);
+    }
+
+    iterator end() {
+        return iterator();
+    }
+
+private:
+    struct impl;
+    explicit seq_reader(std::unique_ptr<impl>);
+    std::unique_ptr<impl> state;
+};
+
+// Pass every feature of a sequence to the callback as soon as it is parsed, from up to options.threads
+// threads at once and in no particular order, so the callback must be thread-safe. Once a record is
+// invalid no further chunks are started, and the error of the first invalid record is thrown after the
+// running ones have finished, regardless of scheduling.
+void for_each_seq_feature(std::string_view, const feature_callback &, const seq_options & = {});
+
+// Pass every feature of a sequence file to the callback like for_each_seq_feature, reading the file like
+// seq_reader::open does.
+void for_each_seq_file_feature(const std::filesystem::path &, const feature_callback &, const seq_options & = {});
+
+// Writes features as a sequence, each as stringify would produce it, on a line of its own.
+class seq_writer {
+public:
+    explicit seq_writer(std::ostream &, seq_format = seq_format::newline_delimited, const stringify_options & = {});
+
+    void write(const feature &);
+    void write(const feature_collection &);
+
+private:
+    std::ostream &output;
+    seq_format format;
+    stringify_options options;
+};
+
+} // namespace geojson
+} // namespace maplibre
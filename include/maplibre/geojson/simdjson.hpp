@@ -0,0 +1,29 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+
+#include <string_view>
+
+#if !defined(GEOJSON_SIMDJSON)
+#error "maplibre/geojson/simdjson.hpp requires building with GEOJSON_SIMDJSON"
+#endif
+
+namespace maplibre {
+namespace geojson {
+
+// Parse with simdjson's On Demand API, which parse() uses for in-memory input when built with
+// GEOJSON_SIMDJSON. Results, including every coordinate bit, and the errors thrown are the same as with
+// parse_rapidjson(): numbers are read the way rapidjson reads them, and input simdjson rejects is parsed
+// by rapidjson instead. Instantiations are provided for geojson, geometry, feature, and
+// feature_collection.
+template <typename T>
+T parse_simdjson(std::string_view, const coordinate_transform<coordinate_type_t<T>> & = {});
+template <typename T>
+T parse_simdjson(std::string_view, const parse_options &, const coordinate_transform<coordinate_type_t<T>> & = {});
+
+// Parse any GeoJSON type with simdjson.
+geojson parse_simdjson(std::string_view);
+geojson parse_simdjson(std::string_view, const parse_options &);
+
+} // namespace geojson
+} // namespace maplibre
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/pmr.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+namespace maplibre {
+namespace geojson {
+
+// Memory resource counting what it hands out from its upstream resource, to be passed to pmr::parse() or
+// pmr::parse_with_stats(). The counters aren't synchronized, so a counting_resource serves one thread at
+// a time, like std::pmr::monotonic_buffer_resource.
+class counting_resource : public std::pmr::memory_resource {
+public:
+    explicit counting_resource(std::pmr::memory_resource *upstream_ = std::pmr::get_default_resource())
+        : upstream(upstream_) {
+    }
+
+    std::size_t allocations() const {
+        return allocationCount;
+    }
+
+    std::size_t bytes_allocated() const {
+        return bytesAllocated;
+    }
+
+    std::size_t bytes_in_use() const {
+        return bytesInUse;
+    }
+
+    // The most bytes in use at once since construction or the last reset_peak().
+    std::size_t peak_bytes() const {
+        return peakBytes;
+    }
+
+    void reset_peak() {
+        peakBytes = bytesInUse;
+    }
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void *block = upstream->allocate(bytes, alignment);
+        ++allocationCount;
+        bytesAllocated += bytes;
+        bytesInUse += bytes;
+        peakBytes = std::max(peakBytes, bytesInUse);
+        return block;
+    }
+
+    void do_deallocate(void *block, std::size_t bytes, std::size_t alignment) override {
+        upstream->deallocate(block, bytes, alignment);
+        bytesInUse -= bytes;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource *upstream;
+    std::size_t allocationCount = 0;
+    std::size_t bytesAllocated  = 0;
+    std::size_t bytesInUse      = 0;
+    std::size_t peakBytes       = 0;
+};
+
+// What a parse_with_stats() call spent, to be exported to metrics.
+struct parse_stats {
+    // Allocations counted during the call, and the most bytes they held at once. What is counted depends
+    // on the variant, see below.
+    std::size_t allocations     = 0;
+    std::size_t bytes_allocated = 0;
+    std::size_t peak_bytes      = 0;
+
+    // The size of the input, and the bytes the rapidjson document built from it takes up. Parses that
+    // build no document report no document size.
+    std::size_t input_bytes    = 0;
+    std::size_t document_bytes = 0;
+
+    // Wall time of the whole call, of tokenizing the input into a document, of converting the document,
+    // and of the validation of coordinate nesting and counts, which is part of converting. Parses that
+    // tokenize and convert in one pass, without a document, can't time the two apart and report zero for
+    // both.
+    std::chrono::nanoseconds elapsed{ 0 };
+    std::chrono::nanoseconds tokenize{ 0 };
+    std::chrono::nanoseconds convert{ 0 };
+    std::chrono::nanoseconds validate{ 0 };
+};
+
+template <class T>
+struct parse_with_stats_result {
+    T result;
+    parse_stats stats;
+};
+
+// Parse in two timed passes: tokenizing the input into a rapidjson document with a pool_allocator, then
+// converting the document through the same handler as parse(). The results and errors are the same as
+// parse()'s. Allocations are the document's chunks and the tokenizer's stack; the result's containers
+// use std::allocator and aren't counted, which pmr::parse_with_stats() does. Instantiations are provided
+// for geojson, geometry, feature, and feature_collection.
+template <class T>
+parse_with_stats_result<T> parse_with_stats(std::string_view, const parse_options & = {});
+
+// Parse any GeoJSON type with statistics.
+parse_with_stats_result<geojson> parse_with_stats(std::string_view, const parse_options & = {});
+
+namespace pmr {
+
+// Parse like pmr::parse() does, in one pass, with the result allocated from the resource, and report what
+// it took. Allocations are all those made from the resource during the call, the result's included.
+// Instantiations are provided for geojson, geometry, feature, and feature_collection.
+template <class T>
+parse_with_stats_result<T> parse_with_stats(std::string_view, counting_resource &);
+
+// Parse any GeoJSON type with statistics.
+parse_with_stats_result<geojson> parse_with_stats(std::string_view, counting_resource &);
+
+} // namespace pmr
+
+// What a stringify_with_stats() call spent.
+struct stringify_stats {
+    // Allocations of the output buffer, the writer's stack, and the returned string.
+    std::size_t allocations     = 0;
+    std::size_t bytes_allocated = 0;
+
+    std::size_t output_bytes = 0;
+    std::chrono::nanoseconds elapsed{ 0 };
+};
+
+struct stringify_with_stats_result {
+    std::string result;
+    stringify_stats stats;
+};
+
+// Stringify like stringify() does and report what it took. Instantiations are provided for geojson,
+// geometry, feature, and feature_collection.
+template <class T>
+stringify_with_stats_result stringify_with_stats(const T &, const stringify_options & = {});
+
+} // namespace geojson
+} // namespace maplibre
@@ -13,6 +13,14 @@ T convert(const maplibre::geojson::value &);
 // Converts Value to GeoJSON type.
 geojson convert(const maplibre::geojson::value &);
 
+// Convert Value to known types with options, as for parse. Instantiations are provided for geojson,
+// geometry, feature, and feature_collection.
+template <class T>
+T convert(const maplibre::geojson::value &, const parse_options &);
+
+// Converts Value to GeoJSON type with options.
+geojson convert(const maplibre::geojson::value &, const parse_options &);
+
 // Convert inputs of known types to Value. Instantiations are provided for geojson, geometry, feature, and
 // feature_collection.
 template <class T>
@@ -0,0 +1,344 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/bbox.hpp>
+
+#include <rapidjson/rapidjson.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace maplibre {
+namespace geojson {
+
+// Serialize known types by sending events straight to a rapidjson::Writer, or any other type
+// implementing rapidjson's Handler interface, without building a rapidjson_value first. The events
+// are the ones convert(const T &, rapidjson_allocator &) followed by Accept() would produce, unless
+// options ask for rounded coordinates.
+template <class Writer>
+void serialize(const geometry &, Writer &, const stringify_options & = {});
+
+template <class Writer>
+void serialize(const feature &, Writer &, const stringify_options & = {});
+
+template <class Writer>
+void serialize(const feature_collection &, Writer &, const stringify_options & = {});
+
+template <class Writer>
+void serialize(const geojson &, Writer &, const stringify_options & = {});
+
+// Formats value rounded to decimals places after the point, without trailing zeros but with at least one
+// decimal, like "12.5" or "3.0". Returns 0 without writing anything when the rounded value isn't exactly
+// representable, in which case the caller has to fall back to shortest round-trip formatting. The
+// buffer must hold 24 characters.
+inline std::size_t formatFixed(double value, int decimals, char *buffer) {
+    static constexpr double powers[] = { 1e0, 1e1, 1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                         1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+    if (decimals < 0 || decimals > 15)
+        return 0;
+
+    const double scaled = value * powers[decimals];
+    // Also rejects NaN and infinity.
+    if (!(std::fabs(scaled) < 9007199254740992.0))
+        return 0;
+
+    const long long rounded = std::llround(scaled);
+    unsigned long long magnitude =
+        rounded < 0 ? 0ULL - static_cast<unsigned long long>(rounded) : static_cast<unsigned long long>(rounded);
+
+    // Least significant digit first.
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = char('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    while (count <= decimals) {
+        digits[count++] = '0';
+    }
+
+    int trailing = 0;
+    while (trailing < decimals - 1 && digits[trailing] == '0') {
+        ++trailing;
+    }
+
+    char *out = buffer;
+    if (rounded < 0) {
+        *out++ = '-';
+    }
+    for (int i = count - 1; i >= decimals; --i) {
+        *out++ = digits[i];
+    }
+    *out++ = '.';
+    if (decimals == 0) {
+        *out++ = '0';
+    }
+    for (int i = decimals - 1; i >= trailing; --i) {
+        *out++ = digits[i];
+    }
+    return std::size_t(out - buffer);
+}
+
+template <class Writer>
+void writeCoordinate(Writer &writer, double coordinate, int decimals) {
+    if (decimals < 0) {
+        writer.Double(coordinate);
+        return;
+    }
+
+    if constexpr (requires(Writer &w) { w.RawValue("", std::size_t(0), rapidjson::kNumberType); }) {
+        char buffer[24];
+        if (const std::size_t length = formatFixed(coordinate, decimals, buffer)) {
+            writer.RawValue(buffer, length, rapidjson::kNumberType);
+            return;
+        }
+        writer.Double(coordinate);
+    } else {
+        // Handlers without RawValue() get the rounded double, which shortest round-trip formatting
+        // prints with at most the requested decimals.
+        const double scale = std::pow(10.0, decimals);
+        const double rounded = std::round(coordinate * scale) / scale;
+        writer.Double(std::isfinite(rounded) ? rounded : coordinate);
+    }
+}
+
+struct to_type {
+public:
+    const char *operator()(const empty &) {
+        abort();
+    }
+
+    const char *operator()(const point &) {
+        return "Point";
+    }
+
+    const char *operator()(const line_string &) {
+        return "LineString";
+    }
+
+    const char *operator()(const polygon &) {
+        return "Polygon";
+    }
+
+    const char *operator()(const multi_point &) {
+        return "MultiPoint";
+    }
+
+    const char *operator()(const multi_line_string &) {
+        return "MultiLineString";
+    }
+
+    const char *operator()(const multi_polygon &) {
+        return "MultiPolygon";
+    }
+
+    const char *operator()(const geometry_collection &) {
+        return "GeometryCollection";
+    }
+};
+
+// Writes a geometry without a "bbox" member, extending bounds, if given, with its positions.
+template <class Writer>
+void writeGeometry(const geometry &, Writer &, const stringify_options &, extent *);
+
+template <class Writer>
+struct write_coordinates_or_geometries {
+    Writer &writer;
+    const stringify_options &options;
+    extent *bounds = nullptr;
+
+    // Handles line_string, polygon, multi_point, multi_line_string, multi_polygon, and geometry_collection.
+    template <class E>
+    void operator()(const std::vector<E> &vector) {
+        writer.StartArray();
+        for (std::size_t i = 0; i < vector.size(); ++i) {
+            operator()(vector[i]);
+        }
+        writer.EndArray();
+    }
+
+    void operator()(const point &element) {
+        if (bounds)
+            bounds->extend(element.x, element.y);
+        writer.StartArray();
+        writeCoordinate(writer, element.x, options.max_decimals);
+        writeCoordinate(writer, element.y, options.max_decimals);
+        writer.EndArray();
+    }
+
+    void operator()(const empty &) {
+        abort();
+    }
+
+    void operator()(const geometry &element) {
+        writeGeometry(element, writer, options, bounds);
+    }
+};
+
+template <class Writer>
+struct write_value {
+    Writer &writer;
+
+    void operator()(null_value_t) {
+        writer.Null();
+    }
+
+    void operator()(bool t) {
+        writer.Bool(t);
+    }
+
+    void operator()(int64_t t) {
+        writer.Int64(t);
+    }
+
+    void operator()(uint64_t t) {
+        writer.Uint64(t);
+    }
+
+    void operator()(double t) {
+        writer.Double(t);
+    }
+
+    void operator()(const std::string &t) {
+        writer.String(t.data(), rapidjson::SizeType(t.size()));
+    }
+
+    void operator()(const std::vector<value> &array) {
+        writer.StartArray();
+        for (const auto &item : array) {
+            std::visit(*this, item);
+        }
+        writer.EndArray();
+    }
+
+    void operator()(const std::shared_ptr<std::vector<value>> &array) {
+        this->operator()(*array);
+    }
+
+    void operator()(const std::unordered_map<std::string, value> &map) {
+        writer.StartObject();
+        for (const auto &property : map) {
+            writer.Key(property.first.data(), rapidjson::SizeType(property.first.size()));
+            std::visit(*this, property.second);
+        }
+        writer.EndObject();
+    }
+
+    void operator()(const std::shared_ptr<std::unordered_map<std::string, value>> &map) {
+        this->operator()(*map);
+    }
+};
+
+// Rounded like coordinates, which keeps the box enclosing the rounded coordinates.
+template <class Writer>
+void writeBbox(Writer &writer, const std::optional<box> &bounds, const stringify_options &options) {
+    if (!bounds)
+        return;
+    writer.Key("bbox");
+    writer.StartArray();
+    writeCoordinate(writer, bounds->min.x, options.max_decimals);
+    writeCoordinate(writer, bounds->min.y, options.max_decimals);
+    writeCoordinate(writer, bounds->max.x, options.max_decimals);
+    writeCoordinate(writer, bounds->max.y, options.max_decimals);
+    writer.EndArray();
+}
+
+template <class Writer>
+void writeGeometryMembers(const geometry &element, Writer &writer, const stringify_options &options, extent *bounds) {
+    writer.Key("type");
+    writer.String(std::visit(to_type(), element));
+    writer.Key(std::holds_alternative<geometry_collection>(element) ? "geometries" : "coordinates");
+    std::visit(write_coordinates_or_geometries<Writer>{ writer, options, bounds }, element);
+}
+
+template <class Writer>
+void writeGeometry(const geometry &element, Writer &writer, const stringify_options &options, extent *bounds) {
+    if (std::holds_alternative<empty>(element)) {
+        writer.Null();
+        return;
+    }
+
+    writer.StartObject();
+    writeGeometryMembers(element, writer, options, bounds);
+    writer.EndObject();
+}
+
+template <class Writer>
+void serialize(const geometry &element, Writer &writer, const stringify_options &options) {
+    if (!options.bbox) {
+        writeGeometry(element, writer, options, nullptr);
+        return;
+    }
+    if (std::holds_alternative<empty>(element)) {
+        writer.Null();
+        return;
+    }
+
+    extent bounds;
+    writer.StartObject();
+    writeGeometryMembers(element, writer, options, &bounds);
+    writeBbox(writer, bounds.bounds(), options);
+    writer.EndObject();
+}
+
+// Extends collectionBounds, if given, with the bounding box of the feature when options ask for them.
+template <class Writer>
+void writeFeature(const feature &element, Writer &writer, const stringify_options &options, extent *collectionBounds) {
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("Feature");
+
+    if (!std::holds_alternative<null_value_t>(element.id)) {
+        writer.Key("id");
+        std::visit(write_value<Writer>{ writer }, element.id);
+    }
+
+    extent bounds;
+    writer.Key("geometry");
+    writeGeometry(element.geometry, writer, options, options.bbox ? &bounds : nullptr);
+    writer.Key("properties");
+    write_value<Writer>{ writer }(element.properties);
+    if (options.bbox) {
+        writeBbox(writer, bounds.bounds(), options);
+        if (collectionBounds)
+            collectionBounds->extend(bounds.bounds());
+    }
+    writer.EndObject();
+}
+
+template <class Writer>
+void serialize(const feature &element, Writer &writer, const stringify_options &options) {
+    writeFeature(element, writer, options, nullptr);
+}
+
+template <class Writer>
+void serialize(const feature_collection &collection, Writer &writer, const stringify_options &options) {
+    extent bounds;
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("FeatureCollection");
+    writer.Key("features");
+    writer.StartArray();
+    for (const auto &element : collection) {
+        writeFeature(element, writer, options, &bounds);
+    }
+    writer.EndArray();
+    if (options.bbox)
+        writeBbox(writer, bounds.bounds(), options);
+    writer.EndObject();
+}
+
+template <class Writer>
+void serialize(const geojson &element, Writer &writer, const stringify_options &options) {
+    std::visit([&](const auto &alternative) { serialize(alternative, writer, options); }, element);
+}
+
+} // namespace geojson
+} // namespace maplibre
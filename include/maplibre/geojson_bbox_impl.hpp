@@ -0,0 +1,89 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/bbox.hpp>
+#include <maplibre/geojson_reader_impl.hpp>
+
+#include <optional>
+#include <string_view>
+#include <variant>
+
+namespace maplibre {
+namespace geojson {
+
+template <class T>
+parse_with_bboxes_result<T> parse_with_bboxes(std::string_view json, const parse_options &options) {
+#if defined(GEOJSON_SIMDJSON)
+    {
+        parse_with_bboxes_result<T> result;
+        reader_handler<T> handler;
+        handler.applyOptions(options);
+        handler.collectBoxes(result.bboxes);
+        if (readSimdjson(json, json.size(), handler)) {
+            result.result = handler.result();
+            return result;
+        }
+    }
+#endif
+    parse_with_bboxes_result<T> result;
+    reader_handler<T> handler;
+    handler.applyOptions(options);
+    handler.collectBoxes(result.bboxes);
+    result.result = read(json.data(), json.size(), handler);
+    return result;
+}
+
+// Instantiate the template.
+template parse_with_bboxes_result<geojson> parse_with_bboxes<geojson>(std::string_view, const parse_options &);
+template parse_with_bboxes_result<geometry> parse_with_bboxes<geometry>(std::string_view, const parse_options &);
+template parse_with_bboxes_result<feature> parse_with_bboxes<feature>(std::string_view, const parse_options &);
+template parse_with_bboxes_result<feature_collection>
+parse_with_bboxes<feature_collection>(std::string_view, const parse_options &);
+
+// Specialized implementation for geojson.
+parse_with_bboxes_result<geojson> parse_with_bboxes(std::string_view json, const parse_options &options) {
+    return parse_with_bboxes<geojson>(json, options);
+}
+
+struct extend_bounds {
+    extent &bounds;
+
+    void operator()(const empty &) {
+    }
+
+    void operator()(const point &element) {
+        bounds.extend(element.x, element.y);
+    }
+
+    template <class E>
+    void operator()(const std::vector<E> &elements) {
+        for (const auto &element : elements) {
+            (*this)(element);
+        }
+    }
+
+    void operator()(const geometry &element) {
+        std::visit(*this, element);
+    }
+};
+
+std::optional<box> bounding_box(const geometry &element) {
+    extent bounds;
+    extend_bounds{ bounds }(element);
+    return bounds.bounds();
+}
+
+std::optional<box> bounding_box(const feature &element) {
+    return bounding_box(element.geometry);
+}
+
+std::optional<box> bounding_box(const feature_collection &collection) {
+    extent bounds;
+    for (const auto &element : collection) {
+        extend_bounds{ bounds }(element.geometry);
+    }
+    return bounds.bounds();
+}
+
+} // namespace geojson
+} // namespace maplibre
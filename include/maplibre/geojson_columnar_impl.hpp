@@ -0,0 +1,340 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/columnar.hpp>
+#include <maplibre/geojson_reader_impl.hpp>
+
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace maplibre {
+namespace geojson {
+
+// An offset of a column, which must fit in 32 bits.
+inline std::uint32_t columnOffset(std::size_t offset) {
+    if (offset > std::numeric_limits<std::uint32_t>::max())
+        throw error("columnar_feature_collection offsets must fit in 32 bits");
+    return static_cast<std::uint32_t>(offset);
+}
+
+columnar_feature_collection::geometry_view::geometry_view(const columnar_feature_collection &collection_,
+                                                          std::uint32_t row_)
+    : collection(&collection_), row(row_) {
+}
+
+geometry_type columnar_feature_collection::geometry_view::type() const {
+    return collection->geometryTypes[row];
+}
+
+std::span<const point> columnar_feature_collection::geometry_view::points() const {
+    const auto &partOffsets = collection->partOffsets;
+    const auto &ringOffsets = collection->ringOffsets;
+    const std::uint32_t begin = ringOffsets[partOffsets[collection->geometryOffsets[row]]];
+    const std::uint32_t end   = ringOffsets[partOffsets[collection->geometryOffsets[collection->subtreeEnd(row)]]];
+    return { collection->coordinates.data() + begin, end - begin };
+}
+
+std::size_t columnar_feature_collection::geometry_view::size() const {
+    return collection->geometryOffsets[row + 1] - collection->geometryOffsets[row];
+}
+
+std::uint32_t columnar_feature_collection::geometry_view::firstRing(std::size_t part) const {
+    return collection->partOffsets[collection->geometryOffsets[row] + part];
+}
+
+std::size_t columnar_feature_collection::geometry_view::rings(std::size_t part) const {
+    return collection->partOffsets[collection->geometryOffsets[row] + part + 1] - firstRing(part);
+}
+
+std::span<const point> columnar_feature_collection::geometry_view::ring(std::size_t part, std::size_t index) const {
+    const std::uint32_t first = firstRing(part) + static_cast<std::uint32_t>(index);
+    const std::uint32_t begin = collection->ringOffsets[first];
+    return { collection->coordinates.data() + begin, collection->ringOffsets[first + 1] - begin };
+}
+
+columnar_feature_collection::geometry_view columnar_feature_collection::geometry_view::member(std::size_t index) const {
+    std::uint32_t member = row + 1;
+    for (std::size_t i = 0; i < index; ++i) {
+        member = collection->subtreeEnd(member);
+    }
+    return { *collection, member };
+}
+
+columnar_feature_collection::geometry_view::operator maplibre::geojson::geometry() const {
+    switch (type()) {
+    case geometry_type::empty:
+        return maplibre::geojson::empty{};
+    case geometry_type::point:
+        return ring(0, 0)[0];
+    case geometry_type::line_string: {
+        const auto points = ring(0, 0);
+        return line_string(points.begin(), points.end());
+    }
+    case geometry_type::multi_point: {
+        const auto points = ring(0, 0);
+        return multi_point(points.begin(), points.end());
+    }
+    case geometry_type::polygon: {
+        polygon result;
+        result.reserve(rings(0));
+        for (std::size_t i = 0; i < rings(0); ++i) {
+            const auto points = ring(0, i);
+            result.emplace_back(points.begin(), points.end());
+        }
+        return result;
+    }
+    case geometry_type::multi_line_string: {
+        multi_line_string result;
+        result.reserve(rings(0));
+        for (std::size_t i = 0; i < rings(0); ++i) {
+            const auto points = ring(0, i);
+            result.emplace_back(points.begin(), points.end());
+        }
+        return result;
+    }
+    case geometry_type::multi_polygon: {
+        multi_polygon result;
+        result.reserve(size());
+        for (std::size_t part = 0; part < size(); ++part) {
+            polygon &element = result.emplace_back();
+            element.reserve(rings(part));
+            for (std::size_t i = 0; i < rings(part); ++i) {
+                const auto points = ring(part, i);
+                element.emplace_back(points.begin(), points.end());
+            }
+        }
+        return result;
+    }
+    case geometry_type::geometry_collection:
+        break;
+    }
+
+    geometry_collection result;
+    result.reserve(size());
+    for (std::uint32_t member = row + 1, end = collection->subtreeEnd(row); member < end;
+         member = collection->subtreeEnd(member)) {
+        result.push_back(maplibre::geojson::geometry(geometry_view(*collection, member)));
+    }
+    return result;
+}
+
+columnar_feature_collection::feature_view::feature_view(const columnar_feature_collection &collection_,
+                                                        std::size_t index_)
+    : collection(&collection_), index(index_) {
+}
+
+columnar_feature_collection::geometry_view columnar_feature_collection::feature_view::geometry() const {
+    return { *collection, collection->featureGeometries[index] };
+}
+
+const identifier &columnar_feature_collection::feature_view::id() const {
+    static const identifier null;
+    return collection->ids.empty() ? null : collection->ids[index];
+}
+
+std::size_t columnar_feature_collection::feature_view::property_count() const {
+    return collection->propertyOffsets[index + 1] - collection->propertyOffsets[index];
+}
+
+std::string_view columnar_feature_collection::feature_view::key_at(std::size_t property) const {
+    return collection->keyNames[collection->propertyKeys[collection->propertyOffsets[index] + property]];
+}
+
+const value &columnar_feature_collection::feature_view::value_at(std::size_t property) const {
+    return collection->propertyValues[collection->propertyOffsets[index] + property];
+}
+
+const value *columnar_feature_collection::feature_view::find(std::string_view key) const {
+    const auto found = collection->keyIndices.find(key);
+    if (found == collection->keyIndices.end())
+        return nullptr;
+    for (std::uint32_t i = collection->propertyOffsets[index]; i < collection->propertyOffsets[index + 1]; ++i) {
+        if (collection->propertyKeys[i] == found->second)
+            return &collection->propertyValues[i];
+    }
+    return nullptr;
+}
+
+columnar_feature_collection::feature_view::operator feature() const {
+    feature result{ maplibre::geojson::geometry(geometry()) };
+    result.properties.reserve(property_count());
+    for (std::size_t i = 0; i < property_count(); ++i) {
+        result.properties.emplace(std::string(key_at(i)), value_at(i));
+    }
+    result.id = id();
+    return result;
+}
+
+columnar_feature_collection::columnar_feature_collection()
+    : ringOffsets{ 0 }, partOffsets{ 0 }, geometryOffsets{ 0 }, propertyOffsets{ 0 } {
+}
+
+columnar_feature_collection::columnar_feature_collection(const feature_collection &collection)
+    : columnar_feature_collection() {
+    featureGeometries.reserve(collection.size());
+    propertyOffsets.reserve(collection.size() + 1);
+    for (const auto &element : collection) {
+        push_back(element);
+    }
+}
+
+void columnar_feature_collection::appendRing(const point *points, std::size_t size) {
+    coordinates.insert(coordinates.end(), points, points + size);
+    ringOffsets.push_back(columnOffset(coordinates.size()));
+}
+
+void columnar_feature_collection::closePart() {
+    partOffsets.push_back(columnOffset(ringOffsets.size() - 1));
+}
+
+void columnar_feature_collection::appendGeometry(const maplibre::geojson::geometry &element) {
+    geometryTypes.push_back(static_cast<geometry_type>(element.index()));
+    std::visit(
+        [&](const auto &alternative) {
+            using type = std::decay_t<decltype(alternative)>;
+            if constexpr (std::is_same_v<type, point>) {
+                appendRing(&alternative, 1);
+                closePart();
+            } else if constexpr (std::is_same_v<type, line_string> || std::is_same_v<type, multi_point>) {
+                appendRing(alternative.data(), alternative.size());
+                closePart();
+            } else if constexpr (std::is_same_v<type, polygon> || std::is_same_v<type, multi_line_string>) {
+                for (const auto &line : alternative) {
+                    appendRing(line.data(), line.size());
+                }
+                closePart();
+            } else if constexpr (std::is_same_v<type, multi_polygon>) {
+                for (const auto &part : alternative) {
+                    for (const auto &line : part) {
+                        appendRing(line.data(), line.size());
+                    }
+                    closePart();
+                }
+            } else if constexpr (std::is_same_v<type, geometry_collection>) {
+                for (std::size_t i = 0; i < alternative.size(); ++i) {
+                    closePart();
+                }
+            }
+        },
+        element);
+    geometryOffsets.push_back(columnOffset(partOffsets.size() - 1));
+
+    // Members follow the row of their collection.
+    if (const auto *members = std::get_if<geometry_collection>(&element)) {
+        for (const auto &member : *members) {
+            appendGeometry(member);
+        }
+    }
+}
+
+std::uint32_t columnar_feature_collection::keyIndex(const std::string &key) {
+    const auto found = keyIndices.find(key);
+    if (found != keyIndices.end())
+        return found->second;
+    const std::uint32_t index = columnOffset(keyNames.size());
+    keyNames.push_back(key);
+    keyIndices.emplace(key, index);
+    return index;
+}
+
+// Copies the property values and id of a const feature and moves those of another.
+template <class Feature>
+void columnar_feature_collection::append(Feature &&element) {
+    constexpr bool copy       = std::is_const_v<std::remove_reference_t<Feature>>;
+    const std::size_t features = size();
+    const std::size_t sizes[]  = { coordinates.size(),   ringOffsets.size(),  partOffsets.size(),
+                                   geometryOffsets.size(), geometryTypes.size(), propertyKeys.size() };
+
+    try {
+        const std::uint32_t row = columnOffset(geometryTypes.size());
+        appendGeometry(element.geometry);
+
+        for (auto &property : element.properties) {
+            propertyKeys.push_back(keyIndex(property.first));
+            if constexpr (copy)
+                propertyValues.push_back(property.second);
+            else
+                propertyValues.push_back(std::move(property.second));
+        }
+        propertyOffsets.push_back(columnOffset(propertyKeys.size()));
+
+        if (!ids.empty() || !std::holds_alternative<null_value_t>(element.id)) {
+            ids.resize(features);
+            if constexpr (copy)
+                ids.push_back(element.id);
+            else
+                ids.push_back(std::move(element.id));
+        }
+        featureGeometries.push_back(row);
+    } catch (...) {
+        // Leave the collection as it was.
+        coordinates.resize(sizes[0]);
+        ringOffsets.resize(sizes[1]);
+        partOffsets.resize(sizes[2]);
+        geometryOffsets.resize(sizes[3]);
+        geometryTypes.resize(sizes[4]);
+        propertyKeys.resize(sizes[5]);
+        propertyValues.resize(sizes[5]);
+        propertyOffsets.resize(features + 1);
+        ids.resize(ids.size() > features ? features : ids.size());
+        throw;
+    }
+}
+
+void columnar_feature_collection::push_back(const feature &element) {
+    append(element);
+}
+
+void columnar_feature_collection::push_back(feature &&element) {
+    append(std::move(element));
+}
+
+std::size_t columnar_feature_collection::size() const {
+    return featureGeometries.size();
+}
+
+columnar_feature_collection::feature_view columnar_feature_collection::operator[](std::size_t index) const {
+    return { *this, index };
+}
+
+std::span<const point> columnar_feature_collection::points() const {
+    return coordinates;
+}
+
+const std::vector<std::string> &columnar_feature_collection::keys() const {
+    return keyNames;
+}
+
+columnar_feature_collection::operator feature_collection() const {
+    feature_collection result;
+    result.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        result.push_back(feature((*this)[i]));
+    }
+    return result;
+}
+
+std::uint32_t columnar_feature_collection::subtreeEnd(std::uint32_t row) const {
+    std::uint32_t end = row + 1;
+    if (geometryTypes[row] == geometry_type::geometry_collection) {
+        for (std::uint32_t i = geometryOffsets[row]; i < geometryOffsets[row + 1]; ++i) {
+            end = subtreeEnd(end);
+        }
+    }
+    return end;
+}
+
+columnar_feature_collection parse_columnar(std::string_view json, const parse_options &options) {
+    columnar_feature_collection result;
+    reader_handler<geojson> handler([&](feature &&element) { result.push_back(std::move(element)); });
+    handler.applyOptions(options);
+    requireFeatureCollection(read(json.data(), json.size(), handler));
+    return result;
+}
+
+} // namespace geojson
+} // namespace maplibre
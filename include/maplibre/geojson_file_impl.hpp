@@ -0,0 +1,134 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace maplibre {
+namespace geojson {
+
+// The contents of a file, memory-mapped read-only when it is a regular file, so that the data is read
+// straight from the page cache, and read into a buffer otherwise, e.g. for pipes. Either way, at least
+// parse_padding bytes past the end are readable, so that parse_padded() reads the contents in place.
+class mapped_file {
+public:
+    explicit mapped_file(const std::filesystem::path &path) {
+#if !defined(_WIN32)
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::runtime_error("cannot open " + path.string() + ": " + std::strerror(errno));
+
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            // The file is mapped over the start of anonymous zero pages, which provide the padding where
+            // the last page of the file doesn't.
+            const std::size_t size     = std::size_t(info.st_size);
+            const std::size_t reserved = size + parse_padding;
+            void *padded = ::mmap(nullptr, reserved, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (padded != MAP_FAILED) {
+                if (::mmap(padded, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) != MAP_FAILED) {
+                    mapping = padded;
+                    length  = size;
+                    mapped  = reserved;
+                    ::close(fd);
+                    return;
+                }
+                ::munmap(padded, reserved);
+            }
+        }
+
+        // Read straight into the buffer rather than through a chunk on the stack.
+        constexpr std::size_t chunk = 65536;
+        for (;;) {
+            const std::size_t used = buffer.size();
+            buffer.resize(used + chunk);
+            const ssize_t count = ::read(fd, buffer.data() + used, chunk);
+            const int code      = errno;
+            buffer.resize(used + std::size_t(count > 0 ? count : 0));
+            if (count == 0)
+                break;
+            if (count < 0 && code != EINTR) {
+                ::close(fd);
+                throw std::runtime_error("cannot read " + path.string() + ": " + std::strerror(code));
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream input(path, std::ios::binary);
+        if (!input)
+            throw std::runtime_error("cannot open " + path.string());
+        buffer.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+#endif
+        buffer.reserve(buffer.size() + parse_padding);
+    }
+
+    mapped_file(const mapped_file &)            = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    ~mapped_file() {
+#if !defined(_WIN32)
+        if (mapping)
+            ::munmap(mapping, mapped);
+#endif
+    }
+
+    // Hints that the data will be read from start to end.
+    void adviseSequential() const {
+#if !defined(_WIN32)
+        if (mapping)
+            ::madvise(mapping, length, MADV_SEQUENTIAL);
+#endif
+    }
+
+    std::string_view data() const {
+        if (mapping)
+            return std::string_view(static_cast<const char *>(mapping), length);
+        return buffer;
+    }
+
+    // The number of bytes readable from the start of data().
+    std::size_t capacity() const {
+        return mapping ? mapped : buffer.capacity();
+    }
+
+private:
+    void *mapping      = nullptr;
+    std::size_t length = 0;
+    std::size_t mapped = 0;
+    std::string buffer;
+};
+
+template <class T>
+T parse_file(const std::filesystem::path &path) {
+    const mapped_file file(path);
+    file.adviseSequential();
+    return parse_padded<T>(file.data(), file.capacity());
+}
+
+// Instantiate the template.
+template geojson parse_file<geojson>(const std::filesystem::path &);
+template geometry parse_file<geometry>(const std::filesystem::path &);
+template feature parse_file<feature>(const std::filesystem::path &);
+template feature_collection parse_file<feature_collection>(const std::filesystem::path &);
+
+// Specialized implementation for geojson.
+geojson parse_file(const std::filesystem::path &path) {
+    return parse_file<geojson>(path);
+}
+
+} // namespace geojson
+} // namespace maplibre
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/flat.hpp>
+#include <maplibre/geojson_reader_impl.hpp>
+
+#include <string_view>
+
+namespace maplibre {
+namespace geojson {
+
+template <class T>
+T flat::parse(std::string_view json, const parse_options &options) {
+    reader_handler<T> handler;
+    handler.applyOptions(options);
+    return read(json.data(), json.size(), handler);
+}
+
+// Instantiate the template.
+template flat::geojson flat::parse<flat::geojson>(std::string_view, const parse_options &);
+template flat::feature flat::parse<flat::feature>(std::string_view, const parse_options &);
+template flat::feature_collection flat::parse<flat::feature_collection>(std::string_view, const parse_options &);
+
+// Specialized implementation for geojson.
+flat::geojson flat::parse(std::string_view json, const parse_options &options) {
+    return flat::parse<flat::geojson>(json, options);
+}
+
+} // namespace geojson
+} // namespace maplibre
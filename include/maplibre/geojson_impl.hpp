@@ -1,14 +1,34 @@
 #pragma once
 
 #include <maplibre/geojson.hpp>
+#include <maplibre/geojson/bbox.hpp>
+#include <maplibre/geojson/flat.hpp>
+#include <maplibre/geojson/interned.hpp>
+#include <maplibre/geojson/members.hpp>
+#include <maplibre/geojson/pmr.hpp>
 #include <maplibre/geojson/rapidjson.hpp>
+#include <maplibre/geojson/writer.hpp>
 
 #include <rapidjson/document.h>
-#include <rapidjson/error/en.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <ostream>
 #include <sstream>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace maplibre {
 namespace geojson {
@@ -16,12 +36,57 @@ namespace geojson {
 using error    = std::runtime_error;
 using prop_map = std::unordered_map<std::string, value>;
 
-void validatePolygon(const rapidjson_value &json) {
+// Validation is timed only by the readers of parse_with_stats(), which are instantiated with a
+// validation_clock. Every other parse uses a no_validation_clock, which compiles to nothing.
+struct no_validation_clock {
+    struct lap {};
+
+    lap start() const {
+        return {};
+    }
+};
+
+// Adds the time of every validation to a total.
+class validation_clock {
+public:
+    class lap {
+    public:
+        explicit lap(std::chrono::nanoseconds &total_) : total(total_), begin(std::chrono::steady_clock::now()) {
+        }
+
+        lap(const lap &)            = delete;
+        lap &operator=(const lap &) = delete;
+
+        ~lap() {
+            total += std::chrono::steady_clock::now() - begin;
+        }
+
+    private:
+        std::chrono::nanoseconds &total;
+        std::chrono::steady_clock::time_point begin;
+    };
+
+    validation_clock() = default;
+
+    explicit validation_clock(std::chrono::nanoseconds &total_) : total(&total_) {
+    }
+
+    lap start() const {
+        return lap(*total);
+    }
+
+private:
+    std::chrono::nanoseconds *total = nullptr;
+};
+
+template <class JSON, class Clock = no_validation_clock>
+void validatePolygon(const JSON &json, const Clock &clock = {}) {
+    [[maybe_unused]] const auto lap = clock.start();
     // this check is required incase case of multipolygon validation
     if (!json.IsArray()) {
         throw error("Coordinates must be nested more deeply.");
     }
-    for (auto &element : json.GetArray()) {
+    for (const auto &element : json.GetArray()) {
         if (!element.IsArray()) {
             throw error("Coordinates must be an array of arrays, each describing a polygon.");
         }
@@ -33,7 +98,9 @@ void validatePolygon(const rapidjson_value &json) {
     }
 }
 
-void validateLineString(const rapidjson_value &json) {
+template <class JSON, class Clock = no_validation_clock>
+void validateLineString(const JSON &json, const Clock &clock = {}) {
+    [[maybe_unused]] const auto lap = clock.start();
     if (json.GetArray().Size() < 2) {
         throw error("A line string must have two or more coordinate points.");
     }
@@ -42,15 +109,300 @@ void validateLineString(const rapidjson_value &json) {
 template <typename T>
 T convert(const rapidjson_value &json);
 
-template <>
-point convert<point>(const rapidjson_value &json) {
-    if (!json.IsArray()) {
-        throw error("coordinates must be an array.");
+// Converts the positions of "coordinates" arrays to points of the coordinate type parsed into.
+template <class CoordT>
+class position_reader {
+public:
+    using coordinate_type = CoordT;
+
+    position_reader() = default;
+
+    explicit position_reader(coordinate_transform<CoordT> transform_) : transform(std::move(transform_)) {
+    }
+
+    // Extends the extent with every position read from now on, until called with nullptr.
+    void measure(extent *target) {
+        bounds = target;
+    }
+
+    maplibre::geometry::point<CoordT> operator()(double x, double y) const {
+        if (bounds)
+            bounds->extend(x, y);
+        if (transform)
+            return transform(x, y);
+        return { convertCoordinate(x), convertCoordinate(y) };
+    }
+
+private:
+    static CoordT convertCoordinate(double coordinate) {
+        if constexpr (std::is_integral_v<CoordT>) {
+            const double rounded = std::round(coordinate);
+            if (!(rounded >= double(std::numeric_limits<CoordT>::min()) &&
+                  rounded < double(std::numeric_limits<CoordT>::max()) + 1.0))
+                throw error("coordinates must be within the range of the coordinate type");
+            return CoordT(rounded);
+        } else {
+            return CoordT(coordinate);
+        }
+    }
+
+    coordinate_transform<CoordT> transform;
+    extent *bounds = nullptr;
+};
+
+// The types a parse produces, and the allocator their storage comes from: the maplibre::geometry and
+// maplibre::feature types with a given coordinate type, allocated on the heap.
+template <class CoordT>
+struct basic_types {
+    using coordinate_type     = CoordT;
+    using allocator_type      = std::allocator<void>;
+    using point               = maplibre::geometry::point<CoordT>;
+    using multi_point         = maplibre::geometry::multi_point<CoordT>;
+    using line_string         = maplibre::geometry::line_string<CoordT>;
+    using multi_line_string   = maplibre::geometry::multi_line_string<CoordT>;
+    using polygon             = maplibre::geometry::polygon<CoordT>;
+    using multi_polygon       = maplibre::geometry::multi_polygon<CoordT>;
+    using geometry            = maplibre::geometry::geometry<CoordT>;
+    using geometry_collection = maplibre::geometry::geometry_collection<CoordT>;
+    using feature             = maplibre::feature::feature<CoordT>;
+    using feature_collection  = maplibre::feature::feature_collection<CoordT>;
+    using geojson             = basic_geojson<CoordT>;
+    using value               = maplibre::geojson::value;
+    using prop_map            = maplibre::geojson::prop_map;
+    using identifier          = maplibre::geojson::identifier;
+    using string              = std::string;
+    using key_string          = std::string;
+
+    // The key of a member, made as soon as the key is read.
+    static key_string makeKey(std::string_view key, const allocator_type &) {
+        return key_string(key);
+    }
+
+    // Keeps the first of duplicate keys, like rapidjson's FindMember() does.
+    static void insert(prop_map &properties, key_string &&key, value &&element, const allocator_type &) {
+        properties.emplace(std::move(key), std::move(element));
+    }
+
+    // Called once all members of an object have been inserted.
+    static void closeObject(prop_map &) {
+    }
+
+    // The value of a nested object, read into a prop_map like properties are.
+    static value makeObject(prop_map &&members) {
+        return value(std::move(members));
+    }
+
+    static feature makeFeature(geometry &&geom, prop_map &&properties, identifier &&id) {
+        feature result{ std::move(geom) };
+        result.properties = std::move(properties);
+        result.id         = std::move(id);
+        return result;
+    }
+};
+
+// The pmr types, allocated from the memory resource a parse was given.
+struct pmr_types {
+    using coordinate_type     = double;
+    using allocator_type      = std::pmr::polymorphic_allocator<>;
+    using point               = pmr::point;
+    using multi_point         = pmr::multi_point;
+    using line_string         = pmr::line_string;
+    using multi_line_string   = pmr::multi_line_string;
+    using polygon             = pmr::polygon;
+    using multi_polygon       = pmr::multi_polygon;
+    using geometry            = pmr::geometry;
+    using geometry_collection = pmr::geometry_collection;
+    using feature             = pmr::feature;
+    using feature_collection  = pmr::feature_collection;
+    using geojson             = pmr::geojson;
+    using value               = pmr::value;
+    using prop_map            = pmr::prop_map;
+    using identifier          = pmr::identifier;
+    using string              = std::pmr::string;
+    using key_string          = std::string;
+
+    static key_string makeKey(std::string_view key, const allocator_type &) {
+        return key_string(key);
+    }
+
+    // Duplicate keys are removed once the object is complete, keeping the first.
+    static void insert(prop_map &properties, key_string &&key, value &&element, const allocator_type &) {
+        properties.emplace_back(std::string_view(key), std::move(element));
+    }
+
+    static void closeObject(prop_map &properties) {
+        removeDuplicateKeys(properties);
+    }
+
+    static value makeObject(prop_map &&members) {
+        return value(std::move(members));
+    }
+
+    // Moving the members in keeps their allocator, where assigning them would copy between resources.
+    static feature makeFeature(geometry &&geom, prop_map &&properties, identifier &&id) {
+        return feature{ std::move(geom), std::move(properties), std::move(id) };
+    }
+};
+
+// The interned types, whose strings are stored in the string table a parse was given.
+struct interned_types {
+    using coordinate_type     = double;
+    using allocator_type      = string_table *;
+    using point               = maplibre::geojson::point;
+    using multi_point         = maplibre::geojson::multi_point;
+    using line_string         = maplibre::geojson::line_string;
+    using multi_line_string   = maplibre::geojson::multi_line_string;
+    using polygon             = maplibre::geojson::polygon;
+    using multi_polygon       = maplibre::geojson::multi_polygon;
+    using geometry            = maplibre::geojson::geometry;
+    using geometry_collection = maplibre::geojson::geometry_collection;
+    using feature             = interned::feature;
+    using feature_collection  = interned::feature_collection;
+    using geojson             = interned::geojson;
+    using value               = interned::value;
+    using prop_map            = interned::prop_map;
+    using identifier          = interned::identifier;
+    using string              = std::string_view;
+    using key_string          = std::string_view;
+
+    // Keys are stored in the table as they are read. Without a table, as in an in-situ parse, they refer
+    // into the input instead.
+    static key_string makeKey(std::string_view key, string_table *strings) {
+        return strings ? strings->key(key) : key;
+    }
+
+    static void insert(prop_map &properties, key_string &&key, value &&element, string_table *) {
+        properties.emplace_back(key, std::move(element));
+    }
+
+    static void closeObject(prop_map &properties) {
+        removeDuplicateKeys(properties);
+    }
+
+    static value makeObject(prop_map &&members) {
+        return value(std::move(members));
+    }
+
+    static feature makeFeature(geometry &&geom, prop_map &&properties, identifier &&id) {
+        return feature{ std::move(geom), std::move(properties), std::move(id) };
+    }
+};
+
+// The flat types, whose properties are kept in a flat::property_map.
+struct flat_types {
+    using coordinate_type     = double;
+    using allocator_type      = std::allocator<void>;
+    using point               = maplibre::geojson::point;
+    using multi_point         = maplibre::geojson::multi_point;
+    using line_string         = maplibre::geojson::line_string;
+    using multi_line_string   = maplibre::geojson::multi_line_string;
+    using polygon             = maplibre::geojson::polygon;
+    using multi_polygon       = maplibre::geojson::multi_polygon;
+    using geometry            = maplibre::geojson::geometry;
+    using geometry_collection = maplibre::geojson::geometry_collection;
+    using feature             = flat::feature;
+    using feature_collection  = flat::feature_collection;
+    using geojson             = flat::geojson;
+    using value               = maplibre::geojson::value;
+    using prop_map            = flat::property_map;
+    using identifier          = maplibre::geojson::identifier;
+    using string              = std::string;
+    using key_string          = std::string;
+
+    static key_string makeKey(std::string_view key, const allocator_type &) {
+        return key_string(key);
+    }
+
+    static void insert(prop_map &properties, key_string &&key, value &&element, const allocator_type &) {
+        properties.emplace(std::move(key), std::move(element));
+    }
+
+    static void closeObject(prop_map &) {
+    }
+
+    // Values hold objects as the usual unordered_map.
+    static value makeObject(prop_map &&members) {
+        return value(static_cast<value::object_type>(members));
+    }
+
+    static feature makeFeature(geometry &&geom, prop_map &&properties, identifier &&id) {
+        return feature{ std::move(geom), std::move(properties), std::move(id) };
     }
-    if (json.Size() < 2)
-        throw error("coordinates array must have at least 2 numbers");
+};
+
+// Constructs T with storage from the allocator if T is a polymorphic allocator-aware container, or
+// stores a string value in the string table of an interned parse, if it has one.
+template <class T, class Allocator, class... Args>
+T construct(const Allocator &allocator, Args &&...args) {
+    if constexpr (std::is_same_v<Allocator, std::pmr::polymorphic_allocator<>>) {
+        return std::make_obj_using_allocator<T>(allocator, std::forward<Args>(args)...);
+    } else if constexpr (std::is_same_v<Allocator, string_table *> && std::is_same_v<T, std::string_view>) {
+        return allocator ? allocator->value(std::forward<Args>(args)...) : T(std::forward<Args>(args)...);
+    } else {
+        return T(std::forward<Args>(args)...);
+    }
+}
 
-    return point{ json[0].GetDouble(), json[1].GetDouble() };
+// Converts a "coordinates" array. JSON is either a rapidjson_value or any type exposing the same
+// read-only array interface, so that every parse path applies identical validation.
+template <typename T, class JSON, class Position, class Allocator>
+T convertCoordinates(const JSON &json, const Position &position, const Allocator &allocator) {
+    if constexpr (std::is_same_v<T, std::invoke_result_t<const Position &, double, double>>) {
+        if (!json.IsArray()) {
+            throw error("coordinates must be an array.");
+        }
+        if (json.Size() < 2 || !json[0].IsNumber() || !json[1].IsNumber())
+            throw error("coordinates array must have at least 2 numbers");
+
+        return position(json[0].GetDouble(), json[1].GetDouble());
+    } else {
+        T points = construct<T>(allocator);
+        if (!json.IsArray()) {
+            throw error("coordinates must be an array of points describing linestring or an array of "
+                        "arrays describing polygons and line strings.");
+        }
+        points.reserve(json.Size());
+
+        for (const auto &element : json.GetArray()) {
+            points.push_back(convertCoordinates<typename T::value_type>(element, position, allocator));
+        }
+        return points;
+    }
+}
+
+template <class Types, class JSON, class Position, class Clock = no_validation_clock>
+typename Types::geometry convertGeometry(std::string_view type,
+                                         const JSON &json_coords,
+                                         const Position &position,
+                                         const typename Types::allocator_type &allocator = {},
+                                         const Clock &clock                              = {}) {
+    using result = typename Types::geometry;
+
+    if (type == "Point")
+        return result{ convertCoordinates<typename Types::point>(json_coords, position, allocator) };
+    if (type == "MultiPoint")
+        return result{ convertCoordinates<typename Types::multi_point>(json_coords, position, allocator) };
+    if (type == "LineString") {
+        validateLineString(json_coords, clock);
+        return result{ convertCoordinates<typename Types::line_string>(json_coords, position, allocator) };
+    }
+    if (type == "MultiLineString") {
+        for (const auto &element : json_coords.GetArray()) {
+            validateLineString(element, clock);
+        }
+        return result{ convertCoordinates<typename Types::multi_line_string>(json_coords, position, allocator) };
+    }
+    if (type == "Polygon") {
+        validatePolygon(json_coords, clock);
+        return result{ convertCoordinates<typename Types::polygon>(json_coords, position, allocator) };
+    }
+    if (type == "MultiPolygon") {
+        for (const auto &element : json_coords.GetArray()) {
+            validatePolygon(element, clock);
+        }
+        return result{ convertCoordinates<typename Types::multi_polygon>(json_coords, position, allocator) };
+    }
+    throw error(std::string(type) + " not yet implemented");
 }
 
 template <typename Cont>
@@ -107,31 +459,9 @@ geometry convert<geometry>(const rapidjson_value &json) {
     if (!json_coords.IsArray())
         throw error("coordinates property must be an array");
 
-    if (type == "Point")
-        return geometry{ convert<point>(json_coords) };
-    if (type == "MultiPoint")
-        return geometry{ convert<multi_point>(json_coords) };
-    if (type == "LineString") {
-        validateLineString(json_coords);
-        return geometry{ convert<line_string>(json_coords) };
-    }
-    if (type == "MultiLineString") {
-        for (auto &element : json_coords.GetArray()) {
-            validateLineString(element);
-        }
-        return geometry{ convert<multi_line_string>(json_coords) };
-    }
-    if (type == "Polygon") {
-        validatePolygon(json_coords);
-        return geometry{ convert<polygon>(json_coords) };
-    }
-    if (type == "MultiPolygon") {
-        for (auto &element : json_coords.GetArray()) {
-            validatePolygon(element);
-        }
-        return geometry{ convert<multi_polygon>(json_coords) };
-    }
-    throw error(std::string(type.GetString()) + " not yet implemented");
+    const auto type_name =
+        type.IsString() ? std::string_view(type.GetString(), type.GetStringLength()) : std::string_view();
+    return convertGeometry<basic_types<double>>(type_name, json_coords, position_reader<double>{});
 }
 
 template <>
@@ -175,6 +505,22 @@ value convert<value>(const rapidjson_value &json) {
     }
 }
 
+// The properties the filter keeps; the values of the others aren't converted.
+inline prop_map convertProperties(const rapidjson_value &json, const property_filter &filter) {
+    if (filter.mode == property_mode::all)
+        return convert<prop_map>(json);
+    if (!json.IsObject())
+        throw error("properties must be an object");
+
+    prop_map result;
+    for (auto &member : json.GetObject()) {
+        const std::string_view key(member.name.GetString(), member.name.GetStringLength());
+        if (filter.keeps(key))
+            result.emplace(std::string(key), convert<value>(member.value));
+    }
+    return result;
+}
+
 template <>
 identifier convert<identifier>(const rapidjson_value &json) {
     switch (json.GetType()) {
@@ -191,8 +537,7 @@ identifier convert<identifier>(const rapidjson_value &json) {
     }
 }
 
-template <>
-feature convert<feature>(const rapidjson_value &json) {
+inline feature convertFeature(const rapidjson_value &json, const property_filter &filter, bool geometries) {
     if (!json.IsObject())
         throw error("Feature must be an object");
 
@@ -209,7 +554,7 @@ feature convert<feature>(const rapidjson_value &json) {
     if (geom_itr == json_end)
         throw error("Feature must have a geometry property");
 
-    feature result{ convert<geometry>(geom_itr->value) };
+    feature result{ geometries ? convert<geometry>(geom_itr->value) : geometry{ empty{} } };
 
     auto const &id_itr = json.FindMember("id");
     if (id_itr != json_end) {
@@ -220,7 +565,7 @@ feature convert<feature>(const rapidjson_value &json) {
     if (prop_itr != json_end) {
         const auto &json_props = prop_itr->value;
         if (!json_props.IsNull()) {
-            result.properties = convert<prop_map>(json_props);
+            result.properties = convertProperties(json_props, filter);
         }
     }
 
@@ -228,7 +573,116 @@ feature convert<feature>(const rapidjson_value &json) {
 }
 
 template <>
-geojson convert<geojson>(const rapidjson_value &json) {
+feature convert<feature>(const rapidjson_value &json) {
+    return convertFeature(json, property_filter{}, true);
+}
+
+inline unsigned resolveThreads(unsigned threads) {
+    return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Runs work on the calling thread and on threads - 1 others, returning once all of them have finished.
+// work must not throw.
+template <class Work>
+void runThreads(unsigned threads, const Work &work) {
+    std::vector<std::thread> pool;
+    struct joiner {
+        std::vector<std::thread> &pool;
+        ~joiner() {
+            for (auto &thread : pool) {
+                thread.join();
+            }
+        }
+    } join{ pool };
+
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back([&work] { work(); });
+    }
+    work();
+}
+
+// The exception thrown at the lowest position by any of several threads, so that the error reported
+// for an input doesn't depend on how its parts were scheduled.
+class first_failure {
+public:
+    // Called from a catch block.
+    void record(std::size_t position) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (position < failed) {
+            failed    = position;
+            exception = std::current_exception();
+        }
+    }
+
+    // Whether work starting at the position can be skipped, as it can't fail first.
+    bool recordedBefore(std::size_t position) const {
+        return failed < position;
+    }
+
+    void rethrow() const {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+private:
+    std::atomic<std::size_t> failed{ std::numeric_limits<std::size_t>::max() };
+    std::exception_ptr exception;
+    std::mutex mutex;
+};
+
+// Features are converted in chunks of this many, handed out to the threads in order.
+constexpr std::size_t featureChunkSize = 256;
+
+// Converts an array of features. With several threads, each converts whole chunks into their slots of
+// the presized collection, and the error of the lowest failing index is thrown, as it would be
+// sequentially; chunks after a known failure are skipped.
+inline feature_collection convertFeatures(const rapidjson_value &json_features, const convert_options &options) {
+    const std::size_t size   = json_features.Size();
+    const std::size_t chunks = (size + featureChunkSize - 1) / featureChunkSize;
+    const auto threads = static_cast<unsigned>(std::min<std::size_t>(resolveThreads(options.threads), chunks));
+
+    feature_collection collection;
+
+    if (threads <= 1) {
+        collection.reserve(size);
+        for (auto &feature_obj : json_features.GetArray()) {
+            collection.push_back(convertFeature(feature_obj, options.properties, options.geometries));
+        }
+        return collection;
+    }
+
+    collection.resize(size);
+
+    std::atomic<std::size_t> next{ 0 };
+    first_failure failure;
+
+    runThreads(threads, [&] {
+        for (std::size_t begin; (begin = next.fetch_add(featureChunkSize)) < size && !failure.recordedBefore(begin);) {
+            const std::size_t end = std::min(begin + featureChunkSize, size);
+            for (std::size_t i = begin; i < end; ++i) {
+                try {
+                    const auto &feature_obj = json_features[static_cast<rapidjson::SizeType>(i)];
+                    collection[i]           = convertFeature(feature_obj, options.properties, options.geometries);
+                } catch (...) {
+                    failure.record(i);
+                    break;
+                }
+            }
+        }
+    });
+
+    failure.rethrow();
+    return collection;
+}
+
+template <typename T>
+T convert(const rapidjson_value &json, const convert_options &) {
+    return convert<T>(json);
+}
+
+template <>
+geojson convert<geojson>(const rapidjson_value &json, const convert_options &options) {
     if (!json.IsObject())
         throw error("GeoJSON must be an object");
 
@@ -250,53 +704,49 @@ geojson convert<geojson>(const rapidjson_value &json) {
         if (!json_features.IsArray())
             throw error("FeatureCollection features property must be an array");
 
-        feature_collection collection;
-
-        const auto &size = json_features.Size();
-        collection.reserve(size);
-
-        for (auto &feature_obj : json_features.GetArray()) {
-            collection.push_back(convert<feature>(feature_obj));
-        }
-
-        return geojson{ collection };
+        return geojson{ convertFeatures(json_features, options) };
     }
 
     if (type == "Feature")
-        return geojson{ convert<feature>(json) };
+        return geojson{ convertFeature(json, options.properties, options.geometries) };
 
     return geojson{ convert<geometry>(json) };
 }
 
-template feature_collection convert<feature_collection>(const rapidjson_value &);
+template <>
+feature convert<feature>(const rapidjson_value &json, const convert_options &options) {
+    return convertFeature(json, options.properties, options.geometries);
+}
 
-template <class T>
-T parse(const std::string &json) {
-    rapidjson_document d;
-    d.Parse(json.c_str());
-    if (d.HasParseError()) {
-        std::stringstream message;
-        message << d.GetErrorOffset() << " - " << rapidjson::GetParseError_En(d.GetParseError());
-        throw error(message.str());
+template <>
+feature_collection convert<feature_collection>(const rapidjson_value &json, const convert_options &options) {
+    if (!json.IsArray()) {
+        throw error("coordinates must be an array of points describing linestring or an array of "
+                    "arrays describing polygons and line strings.");
     }
-    return convert<T>(d);
+    return convertFeatures(json, options);
 }
 
-// Instantiate the template.
-template geojson parse<geojson>(const std::string &);
-template geometry parse<geometry>(const std::string &);
-template feature parse<feature>(const std::string &);
-template feature_collection parse<feature_collection>(const std::string &);
+template <>
+geojson convert<geojson>(const rapidjson_value &json) {
+    return convert<geojson>(json, convert_options{});
+}
 
-// Specialized implementation for geojson.
-geojson parse(const std::string &json) {
-    return parse<geojson>(json);
+template <>
+feature_collection convert<feature_collection>(const rapidjson_value &json) {
+    return convert<feature_collection>(json, convert_options{});
 }
 
+template geometry convert<geometry>(const rapidjson_value &, const convert_options &);
+
 geojson convert(const rapidjson_value &json) {
     return convert<geojson>(json);
 }
 
+geojson convert(const rapidjson_value &json, const convert_options &options) {
+    return convert<geojson>(json, options);
+}
+
 template <>
 rapidjson_value convert<geometry>(const geometry &, rapidjson_allocator &);
 
@@ -306,41 +756,6 @@ rapidjson_value convert<feature>(const feature &, rapidjson_allocator &);
 template <>
 rapidjson_value convert<feature_collection>(const feature_collection &, rapidjson_allocator &);
 
-struct to_type {
-public:
-    const char *operator()(const empty &) {
-        abort();
-    }
-
-    const char *operator()(const point &) {
-        return "Point";
-    }
-
-    const char *operator()(const line_string &) {
-        return "LineString";
-    }
-
-    const char *operator()(const polygon &) {
-        return "Polygon";
-    }
-
-    const char *operator()(const multi_point &) {
-        return "MultiPoint";
-    }
-
-    const char *operator()(const multi_line_string &) {
-        return "MultiLineString";
-    }
-
-    const char *operator()(const multi_polygon &) {
-        return "MultiPolygon";
-    }
-
-    const char *operator()(const geometry_collection &) {
-        return "GeometryCollection";
-    }
-};
-
 struct to_coordinates_or_geometries {
     rapidjson_allocator &allocator;
 
@@ -496,28 +911,105 @@ rapidjson_value convert(const geojson &element, rapidjson_allocator &allocator)
 }
 
 template <class T>
-std::string stringify(const T &t) {
-    rapidjson_allocator allocator;
+std::string stringify(const T &t, const stringify_options &options) {
     rapidjson::StringBuffer buffer;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-    convert(t, allocator).Accept(writer);
+    serialize(t, writer, options);
     return buffer.GetString();
 }
 
 // Instantiate the template.
-template std::string stringify<geometry>(const geometry &);
-template std::string stringify<feature>(const feature &);
-template std::string stringify<feature_collection>(const feature_collection &);
+template std::string stringify<geometry>(const geometry &, const stringify_options &);
+template std::string stringify<feature>(const feature &, const stringify_options &);
+template std::string stringify<feature_collection>(const feature_collection &, const stringify_options &);
 
 // Specialized implementation for geojson.
 template <>
-std::string stringify(const geojson &element) {
-    return stringify(element);
+std::string stringify(const geojson &element, const stringify_options &options) {
+    return stringify(element, options);
 }
 
-std::string stringify(const geojson &element) {
-    return std::visit([](const auto &alternative) { return stringify(alternative); }, element);
+std::string stringify(const geojson &element, const stringify_options &options) {
+    return std::visit([&](const auto &alternative) { return stringify(alternative, options); }, element);
 }
 
+// rapidjson output stream handing the output to a write_callback in chunks of at most 64 KiB. The chunk
+// is allocated on the heap, since writes may run on threads with small stacks.
+class chunk_stream {
+public:
+    using Ch = char;
+
+    static constexpr std::size_t capacity = 65536;
+
+    explicit chunk_stream(const write_callback &callback_)
+        : callback(callback_), chunk(std::make_unique_for_overwrite<char[]>(capacity)) {
+    }
+
+    void Put(Ch c) {
+        if (size == capacity) {
+            Flush();
+        }
+        chunk[size++] = c;
+    }
+
+    void Flush() {
+        if (size > 0) {
+            callback(chunk.get(), size);
+            size = 0;
+        }
+    }
+
+private:
+    const write_callback &callback;
+    std::unique_ptr<char[]> chunk;
+    std::size_t size = 0;
+};
+
+template <class T>
+void write(const T &t, const write_callback &callback, const stringify_options &options) {
+    chunk_stream stream(callback);
+    rapidjson::Writer<chunk_stream> writer(stream);
+    serialize(t, writer, options);
+    stream.Flush();
+}
+
+template <class T>
+void write(const T &t, std::ostream &output, const stringify_options &options) {
+    write(
+        t,
+        [&](const char *data, std::size_t size) {
+            if (!output.write(data, std::streamsize(size)))
+                throw error("Failed to write GeoJSON to stream");
+        },
+        options);
+}
+
+template <class T>
+void write(const T &t, std::FILE *file, const stringify_options &options) {
+    write(
+        t,
+        [&](const char *data, std::size_t size) {
+            if (std::fwrite(data, 1, size, file) != size)
+                throw error("Failed to write GeoJSON to file");
+        },
+        options);
+}
+
+// Instantiate the template.
+template void write<geojson>(const geojson &, const write_callback &, const stringify_options &);
+template void write<geometry>(const geometry &, const write_callback &, const stringify_options &);
+template void write<feature>(const feature &, const write_callback &, const stringify_options &);
+template void write<feature_collection>(const feature_collection &, const write_callback &, const stringify_options &);
+
+template void write<geojson>(const geojson &, std::ostream &, const stringify_options &);
+template void write<geometry>(const geometry &, std::ostream &, const stringify_options &);
+template void write<feature>(const feature &, std::ostream &, const stringify_options &);
+template void write<feature_collection>(const feature_collection &, std::ostream &, const stringify_options &);
+
+template void write<geojson>(const geojson &, std::FILE *, const stringify_options &);
+template void write<geometry>(const geometry &, std::FILE *, const stringify_options &);
+template void write<feature>(const feature &, std::FILE *, const stringify_options &);
+template void write<feature_collection>(const feature_collection &, std::FILE *, const stringify_options &);
+
 } // namespace geojson
 } // namespace maplibre
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/bbox.hpp>
+#include <maplibre/geojson/index.hpp>
+#include <maplibre/geojson_impl.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace maplibre {
+namespace geojson {
+
+// Items per unit of parallel work while building an index.
+constexpr std::size_t indexChunkSize = 4096;
+
+// Calls work(begin, end) for consecutive ranges that together cover [0, count), on up to threads threads.
+// work must not throw.
+template <class Work>
+void forChunks(std::size_t count, unsigned threads, const Work &work) {
+    const std::size_t chunks = (count + indexChunkSize - 1) / indexChunkSize;
+    threads                  = static_cast<unsigned>(std::min<std::size_t>(threads, chunks));
+    if (threads <= 1) {
+        work(std::size_t(0), count);
+        return;
+    }
+
+    std::atomic<std::size_t> next{ 0 };
+    runThreads(threads, [&] {
+        for (std::size_t begin; (begin = next.fetch_add(indexChunkSize)) < count;) {
+            work(begin, std::min(begin + indexChunkSize, count));
+        }
+    });
+}
+
+// The position of (x, y) along a Hilbert curve through a 2^16 by 2^16 grid, as flatbush computes it.
+inline std::uint32_t hilbert(std::uint32_t x, std::uint32_t y) {
+    std::uint32_t a = x ^ y;
+    std::uint32_t b = 0xFFFF ^ a;
+    std::uint32_t c = 0xFFFF ^ (x | y);
+    std::uint32_t d = x & (y ^ 0xFFFF);
+
+    std::uint32_t A = a | (b >> 1);
+    std::uint32_t B = (a >> 1) ^ a;
+    std::uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+    std::uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+    a = A, b = B, c = C, d = D;
+    A = (a & (a >> 2)) ^ (b & (b >> 2));
+    B = (a & (b >> 2)) ^ (b & ((a ^ b) >> 2));
+    C ^= (a & (c >> 2)) ^ (b & (d >> 2));
+    D ^= (b & (c >> 2)) ^ ((a ^ b) & (d >> 2));
+
+    a = A, b = B, c = C, d = D;
+    A = (a & (a >> 4)) ^ (b & (b >> 4));
+    B = (a & (b >> 4)) ^ (b & ((a ^ b) >> 4));
+    C ^= (a & (c >> 4)) ^ (b & (d >> 4));
+    D ^= (b & (c >> 4)) ^ ((a ^ b) & (d >> 4));
+
+    a = A, b = B, c = C, d = D;
+    C ^= (a & (c >> 8)) ^ (b & (d >> 8));
+    D ^= (b & (c >> 8)) ^ ((a ^ b) & (d >> 8));
+
+    a = C ^ (C >> 1);
+    b = D ^ (D >> 1);
+
+    std::uint32_t i0 = x ^ y;
+    std::uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+    i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+    i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+    i0 = (i0 | (i0 << 2)) & 0x33333333;
+    i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+    i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+    i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+    i1 = (i1 | (i1 << 2)) & 0x33333333;
+    i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+    return (i1 << 1) | i0;
+}
+
+// The offset in boxes where each level ends, for items leaves grouped nodeSize to a node.
+inline std::vector<std::size_t> indexLevels(std::size_t items, std::size_t nodeSize) {
+    std::vector<std::size_t> levels;
+    if (!items)
+        return levels;
+    std::size_t count = items;
+    std::size_t nodes = items;
+    levels.push_back(nodes * 4);
+    while (count > 1) {
+        count = (count + nodeSize - 1) / nodeSize;
+        nodes += count;
+        levels.push_back(nodes * 4);
+    }
+    return levels;
+}
+
+feature_index::feature_index() = default;
+
+feature_index::feature_index(const std::vector<std::optional<box>> &bboxes, const index_options &options) {
+    build(bboxes, options);
+}
+
+feature_index::feature_index(const bounding_boxes &bboxes, const index_options &options) {
+    build(bboxes.features, options);
+}
+
+feature_index::feature_index(const feature_collection &collection, const index_options &options) {
+    std::vector<std::optional<box>> bboxes(collection.size());
+    forChunks(collection.size(), resolveThreads(options.threads), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            bboxes[i] = bounding_box(collection[i]);
+        }
+    });
+    build(bboxes, options);
+}
+
+void feature_index::build(const std::vector<std::optional<box>> &bboxes, const index_options &options) {
+    if (bboxes.size() > std::numeric_limits<std::uint32_t>::max())
+        throw error("too many features to index");
+
+    features = bboxes.size();
+    nodeSize = std::max<std::uint16_t>(options.node_size, 2);
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> leaves; // (Hilbert value, feature)
+    extent total;
+    for (std::size_t i = 0; i < bboxes.size(); ++i) {
+        if (bboxes[i]) {
+            leaves.emplace_back(0, static_cast<std::uint32_t>(i));
+            total.extend(bboxes[i]);
+        }
+    }
+
+    items       = leaves.size();
+    levelBounds = indexLevels(items, nodeSize);
+    if (!items)
+        return;
+    if (levelBounds.back() > std::numeric_limits<std::uint32_t>::max())
+        throw error("too many features to index");
+
+    const unsigned threads = resolveThreads(options.threads);
+    const box bounds       = *total.bounds();
+    const double width     = bounds.max.x - bounds.min.x;
+    const double height    = bounds.max.y - bounds.min.y;
+    const auto gridCell    = [](double offset, double size) {
+        return size > 0 ? static_cast<std::uint32_t>(65535 * (offset / size)) : std::uint32_t(0);
+    };
+
+    forChunks(items, threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const box &leaf = *bboxes[leaves[i].second];
+            const double x  = (leaf.min.x + leaf.max.x) / 2 - bounds.min.x;
+            const double y  = (leaf.min.y + leaf.max.y) / 2 - bounds.min.y;
+            leaves[i].first = hilbert(gridCell(x, width), gridCell(y, height));
+        }
+    });
+
+    // Sort runs of leaves in parallel, then merge them pairwise. Ties are broken by feature, so the order
+    // doesn't depend on the runs.
+    const std::size_t runs    = std::min<std::size_t>(threads, (items + indexChunkSize - 1) / indexChunkSize);
+    const std::size_t runSize = (items + runs - 1) / runs;
+    if (runs <= 1) {
+        std::sort(leaves.begin(), leaves.end());
+    } else {
+        std::atomic<std::size_t> next{ 0 };
+        runThreads(static_cast<unsigned>(runs), [&] {
+            for (std::size_t run; (run = next.fetch_add(1)) < runs;) {
+                std::sort(leaves.begin() + std::min(run * runSize, items),
+                          leaves.begin() + std::min((run + 1) * runSize, items));
+            }
+        });
+        for (std::size_t merged = runSize; merged < items; merged *= 2) {
+            for (std::size_t begin = 0; begin + merged < items; begin += 2 * merged) {
+                std::inplace_merge(leaves.begin() + begin, leaves.begin() + begin + merged,
+                                   leaves.begin() + std::min(begin + 2 * merged, items));
+            }
+        }
+    }
+
+    boxes.assign(levelBounds.back(), 0);
+    indices.assign(levelBounds.back() / 4, 0);
+
+    forChunks(items, threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const box &leaf  = *bboxes[leaves[i].second];
+            boxes[i * 4]     = leaf.min.x;
+            boxes[i * 4 + 1] = leaf.min.y;
+            boxes[i * 4 + 2] = leaf.max.x;
+            boxes[i * 4 + 3] = leaf.max.y;
+            indices[i]       = leaves[i].second;
+        }
+    });
+
+    // Each level's nodes enclose consecutive groups of the level below, and only depend on that level.
+    const std::size_t stride = std::size_t(nodeSize) * 4;
+    for (std::size_t level = 0; level + 1 < levelBounds.size(); ++level) {
+        const std::size_t childBegin = level ? levelBounds[level - 1] : 0;
+        const std::size_t childEnd   = levelBounds[level];
+        const std::size_t nodes      = (levelBounds[level + 1] - childEnd) / 4;
+
+        forChunks(nodes, threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t node = begin; node < end; ++node) {
+                const std::size_t first = childBegin + node * stride;
+                const std::size_t last  = std::min(first + stride, childEnd);
+                extent enclosing;
+                for (std::size_t child = first; child < last; child += 4) {
+                    enclosing.extend(boxes[child], boxes[child + 1]);
+                    enclosing.extend(boxes[child + 2], boxes[child + 3]);
+                }
+                const box nodeBounds  = *enclosing.bounds();
+                const std::size_t pos = childEnd + node * 4;
+                boxes[pos]            = nodeBounds.min.x;
+                boxes[pos + 1]        = nodeBounds.min.y;
+                boxes[pos + 2]        = nodeBounds.max.x;
+                boxes[pos + 3]        = nodeBounds.max.y;
+                indices[pos / 4]      = static_cast<std::uint32_t>(first);
+            }
+        });
+    }
+}
+
+std::size_t feature_index::size() const {
+    return features;
+}
+
+std::size_t feature_index::upperBound(std::size_t node) const {
+    return *std::upper_bound(levelBounds.begin(), levelBounds.end(), node);
+}
+
+std::vector<std::size_t> feature_index::query(const box &bounds) const {
+    std::vector<std::size_t> results;
+    if (boxes.empty())
+        return results;
+
+    std::vector<std::size_t> queue;
+    std::size_t node = boxes.size() - 4;
+    for (;;) {
+        const std::size_t end = std::min(node + std::size_t(nodeSize) * 4, upperBound(node));
+        for (std::size_t pos = node; pos < end; pos += 4) {
+            if (bounds.max.x < boxes[pos] || bounds.max.y < boxes[pos + 1] || bounds.min.x > boxes[pos + 2] ||
+                bounds.min.y > boxes[pos + 3])
+                continue;
+            if (node >= items * 4) {
+                queue.push_back(indices[pos / 4]);
+            } else {
+                results.push_back(indices[pos / 4]);
+            }
+        }
+        if (queue.empty())
+            break;
+        node = queue.back();
+        queue.pop_back();
+    }
+
+    std::sort(results.begin(), results.end());
+    return results;
+}
+
+// The serialized form: the magic bytes, then the format version, node size, feature count, and leaf count,
+// followed by the boxes and indices arrays.
+constexpr char indexMagic[4]          = { 'G', 'J', 'R', 'T' };
+constexpr std::uint32_t indexVersion  = 1;
+constexpr std::size_t indexHeaderSize = 4 + 4 + 4 + 8 + 8;
+
+inline void writeLittleEndian(std::string &out, std::uint64_t number, std::size_t bytes) {
+    for (std::size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((number >> (8 * i)) & 0xFF));
+    }
+}
+
+inline std::uint64_t readLittleEndian(const char *in, std::size_t bytes) {
+    std::uint64_t number = 0;
+    for (std::size_t i = 0; i < bytes; ++i) {
+        number |= std::uint64_t(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    return number;
+}
+
+std::string feature_index::serialize() const {
+    std::string out;
+    out.reserve(indexHeaderSize + boxes.size() * 8 + indices.size() * 4);
+    out.append(indexMagic, sizeof(indexMagic));
+    writeLittleEndian(out, indexVersion, 4);
+    writeLittleEndian(out, nodeSize, 4);
+    writeLittleEndian(out, features, 8);
+    writeLittleEndian(out, items, 8);
+    for (const double coordinate : boxes) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &coordinate, sizeof(bits));
+        writeLittleEndian(out, bits, 8);
+    }
+    for (const std::uint32_t index : indices) {
+        writeLittleEndian(out, index, 4);
+    }
+    return out;
+}
+
+feature_index feature_index::deserialize(std::string_view data) {
+    if (data.size() < indexHeaderSize || data.compare(0, sizeof(indexMagic), indexMagic, sizeof(indexMagic)) != 0)
+        throw error("not a serialized feature index");
+    if (readLittleEndian(data.data() + 4, 4) != indexVersion)
+        throw error("unsupported feature index version");
+
+    const std::uint64_t nodes    = readLittleEndian(data.data() + 8, 4);
+    const std::uint64_t features = readLittleEndian(data.data() + 12, 8);
+    const std::uint64_t items    = readLittleEndian(data.data() + 20, 8);
+    if (nodes < 2 || nodes > std::numeric_limits<std::uint16_t>::max() || items > features ||
+        features > std::numeric_limits<std::uint32_t>::max())
+        throw error("corrupt feature index");
+
+    feature_index result;
+    result.nodeSize    = static_cast<std::uint16_t>(nodes);
+    result.features    = features;
+    result.items       = items;
+    result.levelBounds = indexLevels(items, nodes);
+
+    const std::size_t numbers = result.levelBounds.empty() ? 0 : result.levelBounds.back();
+    if (data.size() != indexHeaderSize + numbers * 8 + numbers)
+        throw error("corrupt feature index");
+
+    const char *in = data.data() + indexHeaderSize;
+    result.boxes.resize(numbers);
+    for (double &coordinate : result.boxes) {
+        const std::uint64_t bits = readLittleEndian(in, 8);
+        std::memcpy(&coordinate, &bits, sizeof(bits));
+        in += 8;
+    }
+
+    // Leaves must name a feature and nodes must point to children stored before them, so that queries stay
+    // within the arrays.
+    result.indices.resize(numbers / 4);
+    for (std::size_t i = 0; i < result.indices.size(); ++i, in += 4) {
+        const auto index   = static_cast<std::uint32_t>(readLittleEndian(in, 4));
+        result.indices[i]  = index;
+        const bool invalid = i < items ? index >= features : index % 4 != 0 || index >= i * 4;
+        if (invalid)
+            throw error("corrupt feature index");
+    }
+
+    return result;
+}
+
+} // namespace geojson
+} // namespace maplibre
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/interned.hpp>
+#include <maplibre/geojson/value.hpp>
+#include <maplibre/geojson_reader_impl.hpp>
+#include <maplibre/geojson_value_impl.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+namespace maplibre {
+namespace geojson {
+
+// Bytes per block of a string table. Longer strings get a block of their own.
+constexpr std::size_t stringBlockSize = 64 * 1024;
+
+string_table::string_table(std::size_t max_shared_value) : maxSharedValue(max_shared_value) {
+}
+
+string_table::string_table(string_table &&) noexcept            = default;
+string_table &string_table::operator=(string_table &&) noexcept = default;
+string_table::~string_table()                                   = default;
+
+std::string_view string_table::store(std::string_view string) {
+    if (string.size() > available) {
+        const std::size_t size = std::max(string.size(), stringBlockSize);
+        blocks.push_back(std::make_unique<char[]>(size));
+        next      = blocks.back().get();
+        available = size;
+    }
+    if (!string.empty())
+        std::memcpy(next, string.data(), string.size());
+    const std::string_view stored(next, string.size());
+    next += string.size();
+    available -= string.size();
+    ++count;
+    length += string.size();
+    return stored;
+}
+
+std::string_view string_table::share(std::string_view string) {
+    const auto found = shared.find(string);
+    if (found != shared.end())
+        return *found;
+    const std::string_view stored = store(string);
+    shared.insert(stored);
+    return stored;
+}
+
+std::string_view string_table::key(std::string_view string) {
+    return share(string);
+}
+
+std::string_view string_table::value(std::string_view string) {
+    return string.size() <= maxSharedValue ? share(string) : store(string);
+}
+
+std::size_t string_table::size() const {
+    return count;
+}
+
+std::size_t string_table::bytes() const {
+    return length;
+}
+
+template <class T>
+T interned::parse(std::string_view json, string_table &strings, const parse_options &options) {
+    reader_handler<T> handler(strings);
+    handler.applyOptions(options);
+    return read(json.data(), json.size(), handler);
+}
+
+// Instantiate the template.
+template interned::geojson
+interned::parse<interned::geojson>(std::string_view, string_table &, const parse_options &);
+template interned::feature
+interned::parse<interned::feature>(std::string_view, string_table &, const parse_options &);
+template interned::feature_collection
+interned::parse<interned::feature_collection>(std::string_view, string_table &, const parse_options &);
+
+// Specialized implementation for geojson.
+interned::geojson interned::parse(std::string_view json, string_table &strings, const parse_options &options) {
+    return interned::parse<interned::geojson>(json, strings, options);
+}
+
+template <class T>
+T interned::parse_insitu(char *json, std::size_t length, const parse_options &options) {
+    reader_handler<T> handler;
+    handler.applyOptions(options);
+    insitu_stream stream(json, length);
+    handler.scanFrom(stream.cursor(), stream.end());
+    return read<rapidjson::kParseInsituFlag>(stream, handler);
+}
+
+// Instantiate the template.
+template interned::geojson interned::parse_insitu<interned::geojson>(char *, std::size_t, const parse_options &);
+template interned::feature interned::parse_insitu<interned::feature>(char *, std::size_t, const parse_options &);
+template interned::feature_collection
+interned::parse_insitu<interned::feature_collection>(char *, std::size_t, const parse_options &);
+
+// Specialized implementation for geojson.
+interned::geojson interned::parse_insitu(char *json, std::size_t length, const parse_options &options) {
+    return interned::parse_insitu<interned::geojson>(json, length, options);
+}
+
+interned::value internValue(const value &element, string_table &strings) {
+    return std::visit(
+        overloaded{ [&](const std::string &string) -> interned::value { return strings.value(string); },
+                    [&](const value::array_ptr_type &array) -> interned::value {
+                        interned::value::array_type result;
+                        result.reserve(array->size());
+                        for (const auto &item : *array) {
+                            result.push_back(internValue(item, strings));
+                        }
+                        return result;
+                    },
+                    [&](const value::object_ptr_type &object) -> interned::value {
+                        interned::value::object_type result;
+                        result.reserve(object->size());
+                        for (const auto &member : *object) {
+                            result.emplace_back(strings.key(member.first), internValue(member.second, strings));
+                        }
+                        return result;
+                    },
+                    [](const auto &scalar) -> interned::value { return scalar; } },
+        element);
+}
+
+// Converts a feature like the value path does, but with its properties and id in the table. The
+// feature is validated and its geometry converted by convertFeature(), which is told to drop the
+// properties so that they aren't copied before they are interned.
+interned::feature internFeature(const value &element, string_table &strings, const parse_options &options) {
+    const parse_options withoutProperties{ { property_mode::none, {} }, options.geometries };
+    feature converted = convertFeature(element, withoutProperties);
+
+    interned::feature result{ std::move(converted.geometry), {}, {} };
+    result.id = std::visit(
+        overloaded{ [&](const std::string &string) -> interned::identifier { return strings.value(string); },
+                    [](const auto &scalar) -> interned::identifier { return scalar; } },
+        converted.id);
+
+    const auto &members     = *element.getObject();
+    const auto properties   = members.find("properties");
+    const auto *propertyMap = properties == members.end() ? nullptr : properties->second.getObject().get();
+    if (propertyMap && options.properties.mode != property_mode::none) {
+        result.properties.reserve(propertyMap->size());
+        for (const auto &property : *propertyMap) {
+            if (options.properties.keeps(property.first))
+                result.properties.emplace_back(strings.key(property.first), internValue(property.second, strings));
+        }
+    }
+    return result;
+}
+
+template <>
+interned::feature interned::convert<interned::feature>(const maplibre::geojson::value &element,
+                                                       string_table &strings,
+                                                       const parse_options &options) {
+    return internFeature(element, strings, options);
+}
+
+template <>
+interned::feature_collection interned::convert<interned::feature_collection>(const maplibre::geojson::value &element,
+                                                                             string_table &strings,
+                                                                             const parse_options &options) {
+    if (!std::holds_alternative<std::shared_ptr<std::vector<maplibre::geojson::value>>>(element)) {
+        throw error("coordinates must be of an Array type");
+    }
+
+    const auto &featureArray = *element.getArray();
+    interned::feature_collection collection;
+    collection.reserve(featureArray.size());
+    for (const auto &featureValue : featureArray) {
+        collection.push_back(internFeature(featureValue, strings, options));
+    }
+    return collection;
+}
+
+template <>
+interned::geojson interned::convert<interned::geojson>(const maplibre::geojson::value &element,
+                                                       string_table &strings,
+                                                       const parse_options &options) {
+    auto valueObject = element.getObject();
+    if (!valueObject) {
+        throw error("GeoJSON must be an object");
+    }
+
+    auto typeIt = valueObject->find("type");
+    if (typeIt == valueObject->end()) {
+        throw error("GeoJSON must have a type property");
+    }
+
+    const auto *typeString = typeIt->second.getString();
+    if (!typeString) {
+        throw error("GeoJSON 'type' property must be of a String type");
+    }
+
+    if (*typeString == "FeatureCollection") {
+        auto featuresIt = valueObject->find("features");
+        if (featuresIt == valueObject->end()) {
+            throw error("FeatureCollection must have features property");
+        }
+
+        const auto featureArray = featuresIt->second.getArray();
+        if (!featureArray) {
+            throw error("FeatureCollection features property must be an array");
+        }
+
+        return interned::convert<interned::feature_collection>(maplibre::geojson::value{ featureArray }, strings,
+                                                               options);
+    }
+
+    if (*typeString == "Feature") {
+        return internFeature(element, strings, options);
+    }
+
+    return maplibre::geojson::convert<geometry>(element);
+}
+
+// Specialized implementation for geojson.
+interned::geojson interned::convert(const maplibre::geojson::value &element,
+                                   string_table &strings,
+                                   const parse_options &options) {
+    return std::visit(
+        overloaded{ [](const null_value_t &) -> interned::geojson { return geometry{}; },
+                    [&](const std::string &jsonString) -> interned::geojson {
+                        if (jsonString == "null")
+                            return geometry{};
+                        return interned::parse(jsonString, strings, options);
+                    },
+                    [&](const maplibre::geojson::value::object_ptr_type &) -> interned::geojson {
+                        return interned::convert<interned::geojson>(element, strings, options);
+                    },
+                    [](const auto &) -> interned::geojson { throw error("Invalid GeoJSON value was provided."); } },
+        element);
+}
+
+} // namespace geojson
+} // namespace maplibre
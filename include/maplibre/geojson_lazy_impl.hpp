@@ -0,0 +1,178 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/lazy.hpp>
+#include <maplibre/geojson/rapidjson.hpp>
+#include <maplibre/geojson_impl.hpp>
+
+#include <rapidjson/error/en.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace maplibre {
+namespace geojson {
+
+lazy_feature_collection::lazy_feature_collection(std::string_view json)
+    : document(std::make_unique<rapidjson_document>()) {
+    document->Parse(json.data(), json.size());
+    if (document->HasParseError()) {
+        std::stringstream message;
+        message << document->GetErrorOffset() << " - " << rapidjson::GetParseError_En(document->GetParseError());
+        throw error(message.str());
+    }
+    index();
+}
+
+lazy_feature_collection::lazy_feature_collection(rapidjson_document &&json)
+    : document(std::make_unique<rapidjson_document>(std::move(json))) {
+    index();
+}
+
+lazy_feature_collection::lazy_feature_collection(lazy_feature_collection &&) noexcept            = default;
+lazy_feature_collection &lazy_feature_collection::operator=(lazy_feature_collection &&) noexcept = default;
+lazy_feature_collection::~lazy_feature_collection()                                            = default;
+
+// Finds the features array, with the errors convert<geojson>() throws for a FeatureCollection.
+void lazy_feature_collection::index() {
+    const rapidjson_value &json = *document;
+    if (json.IsArray()) {
+        features = &json;
+    } else {
+        if (!json.IsObject())
+            throw error("GeoJSON must be an object");
+
+        const auto &type_itr = json.FindMember("type");
+        if (type_itr == json.MemberEnd())
+            throw error("GeoJSON must have a type property");
+        if (type_itr->value != "FeatureCollection")
+            throw error("GeoJSON must be a FeatureCollection");
+
+        const auto &features_itr = json.FindMember("features");
+        if (features_itr == json.MemberEnd())
+            throw error("FeatureCollection must have features property");
+        if (!features_itr->value.IsArray())
+            throw error("FeatureCollection features property must be an array");
+
+        features = &features_itr->value;
+    }
+    cache.resize(features->Size());
+}
+
+std::size_t lazy_feature_collection::size() const {
+    return cache.size();
+}
+
+// The feature's object, checked as far as convert<feature>() checks it before converting its geometry.
+const rapidjson_value &lazy_feature_collection::element(std::size_t i) const {
+    const rapidjson_value &json = (*features)[static_cast<rapidjson::SizeType>(i)];
+    if (!json.IsObject())
+        throw error("Feature must be an object");
+
+    const auto &type_itr = json.FindMember("type");
+    if (type_itr == json.MemberEnd())
+        throw error("Feature must have a type property");
+    if (type_itr->value != "Feature")
+        throw error("Feature type must be Feature");
+    if (!json.HasMember("geometry"))
+        throw error("Feature must have a geometry property");
+    return json;
+}
+
+// Converts the parts of the feature not cached yet, in the order convert<feature>() converts them, so that
+// a whole feature throws the same error.
+lazy_feature_collection::entry &lazy_feature_collection::load(std::size_t i, std::uint8_t parts) const {
+    auto &cached = cache[i];
+    if (cached && (cached->parts & parts) == parts)
+        return *cached;
+
+    const rapidjson_value &json = element(i);
+    if (!cached)
+        cached = std::make_unique<entry>();
+
+    if ((parts & geometryPart) && !(cached->parts & geometryPart)) {
+        cached->value.geometry = convert<maplibre::geojson::geometry>(json["geometry"]);
+        cached->parts |= geometryPart;
+    }
+
+    if ((parts & idPart) && !(cached->parts & idPart)) {
+        const auto &id_itr = json.FindMember("id");
+        if (id_itr != json.MemberEnd())
+            cached->value.id = convert<identifier>(id_itr->value);
+        cached->parts |= idPart;
+    }
+
+    if ((parts & propertiesPart) && !(cached->parts & propertiesPart)) {
+        const auto &prop_itr = json.FindMember("properties");
+        if (prop_itr != json.MemberEnd() && !prop_itr->value.IsNull())
+            cached->value.properties = convert<prop_map>(prop_itr->value);
+        cached->parts |= propertiesPart;
+    }
+
+    return *cached;
+}
+
+const feature &lazy_feature_collection::operator[](std::size_t i) const {
+    return load(i, geometryPart | propertiesPart | idPart).value;
+}
+
+const feature &lazy_feature_collection::at(std::size_t i) const {
+    if (i >= size())
+        throw std::out_of_range("feature index " + std::to_string(i) + " out of range");
+    return (*this)[i];
+}
+
+const geometry &lazy_feature_collection::geometry_at(std::size_t i) const {
+    return load(i, geometryPart).value.geometry;
+}
+
+const maplibre::feature::property_map &lazy_feature_collection::properties_at(std::size_t i) const {
+    return load(i, propertiesPart).value.properties;
+}
+
+const identifier &lazy_feature_collection::id_at(std::size_t i) const {
+    return load(i, idPart).value.id;
+}
+
+// Compares ids without validating the rest of each feature, so that an invalid feature doesn't stop the
+// search. Only string and number ids are compared: features without one, and null ids, match nothing.
+std::optional<std::size_t> lazy_feature_collection::find(const identifier &id) const {
+    if (std::holds_alternative<null_value_t>(id))
+        return std::nullopt;
+
+    for (std::size_t i = 0; i < size(); ++i) {
+        if (cache[i] && (cache[i]->parts & idPart)) {
+            if (cache[i]->value.id == id)
+                return i;
+            continue;
+        }
+
+        const rapidjson_value &json = (*features)[static_cast<rapidjson::SizeType>(i)];
+        if (!json.IsObject())
+            continue;
+        const auto &id_itr = json.FindMember("id");
+        if (id_itr != json.MemberEnd() && (id_itr->value.IsString() || id_itr->value.IsNumber()) &&
+            convert<identifier>(id_itr->value) == id)
+            return i;
+    }
+    return std::nullopt;
+}
+
+lazy_feature_collection::operator feature_collection() const {
+    feature_collection result;
+    result.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        // Features not cached whole are converted straight into the result, so that they aren't held twice.
+        const auto &cached = cache[i];
+        if (cached && cached->parts == (geometryPart | propertiesPart | idPart))
+            result.push_back(cached->value);
+        else
+            result.push_back(convert<feature>(element(i)));
+    }
+    return result;
+}
+
+} // namespace geojson
+} // namespace maplibre
@@ -0,0 +1,1806 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/rapidjson.hpp>
+#include <maplibre/geojson_impl.hpp>
+
+#if defined(GEOJSON_SIMDJSON)
+#include <maplibre/geojson/simdjson.hpp>
+
+#include <simdjson.h>
+#endif
+
+#include <rapidjson/encodedstream.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/filereadstream.h>
+#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace maplibre {
+namespace geojson {
+
+// A "coordinates" member flattened in document order. GeoJSON doesn't require "type" to precede
+// "coordinates", so they are buffered until the enclosing object ends.
+struct coordinate_token {
+    enum kind : std::uint8_t {
+        number,
+        array,
+        other
+    };
+
+    double value;
+    std::uint32_t size; // number of elements, for arrays
+    std::uint32_t end;  // index one past the last token of this subtree
+    kind type;
+};
+
+using coordinates_buffer = std::vector<coordinate_token>;
+
+// Exposes a coordinates_buffer through the subset of the rapidjson_value interface used by
+// convertCoordinates(), so buffered coordinates go through the same validation as a parsed document.
+class coordinates_view {
+public:
+    struct iterator {
+        const coordinates_buffer *tokens;
+        std::uint32_t index;
+
+        coordinates_view operator*() const {
+            return { *tokens, index };
+        }
+
+        iterator &operator++() {
+            index = (*tokens)[index].end;
+            return *this;
+        }
+
+        bool operator!=(const iterator &other) const {
+            return index != other.index;
+        }
+    };
+
+    coordinates_view(const coordinates_buffer &tokens_, std::uint32_t index_ = 0) : tokens(&tokens_), index(index_) {
+    }
+
+    bool IsArray() const {
+        return token().type == coordinate_token::array;
+    }
+
+    bool IsNumber() const {
+        return token().type == coordinate_token::number;
+    }
+
+    std::uint32_t Size() const {
+        return token().size;
+    }
+
+    double GetDouble() const {
+        return token().value;
+    }
+
+    const coordinates_view &GetArray() const {
+        return *this;
+    }
+
+    coordinates_view operator[](std::uint32_t i) const {
+        std::uint32_t child = index + 1;
+        while (i-- > 0) {
+            child = (*tokens)[child].end;
+        }
+        return { *tokens, child };
+    }
+
+    iterator begin() const {
+        return { tokens, index + 1 };
+    }
+
+    iterator end() const {
+        return { tokens, token().end };
+    }
+
+private:
+    const coordinate_token &token() const {
+        return (*tokens)[index];
+    }
+
+    const coordinates_buffer *tokens;
+    std::uint32_t index;
+};
+
+// A converted value, or the message of the error its conversion raised. Errors are only thrown after
+// the whole input was tokenized, so that syntax errors take precedence as they do for a parsed
+// document, and only once the enclosing object's type tells whether the member matters at all.
+template <class T>
+struct deferred {
+    T value{};
+    std::string message;
+
+    T take() {
+        if (!message.empty())
+            throw error(message);
+        return std::move(value);
+    }
+};
+
+// What the next JSON value is read as.
+enum class reader_slot : std::uint8_t {
+    skip,
+    geojson,
+    geometry,
+    feature,
+    collection, // top-level array of features, as read by parse<feature_collection>
+    features,
+    geometries,
+    coordinates,
+    type,
+    id,
+    properties,
+    bbox,
+    value
+};
+
+// The members of a GeoJSON object collected so far. Which members are collected depends on the role:
+// geometries keep "coordinates" and "geometries", features keep "geometry", "id" and "properties",
+// and a top-level geojson object keeps all of them plus "features".
+template <class Types>
+struct reader_object {
+    explicit reader_object(reader_slot role_) : role(role_) {
+    }
+
+    reader_slot role;
+    reader_slot member = reader_slot::skip;
+    std::optional<std::string> type;
+    std::optional<coordinates_buffer> coordinates;
+    std::optional<deferred<typename Types::geometry_collection>> geometries;
+    std::optional<deferred<typename Types::geometry>> geom;
+    std::optional<deferred<typename Types::feature_collection>> features;
+    std::optional<deferred<typename Types::identifier>> id;
+    std::optional<deferred<typename Types::prop_map>> properties;
+    // Only read when bounding boxes are collected.
+    std::optional<box> bbox;
+    extent geometryBounds;   // of the "geometry" member
+    extent geometriesBounds; // of the elements of "geometries"
+    extent featuresBounds;   // of the elements of "features"
+};
+
+struct reader_coordinates {
+    coordinates_buffer tokens;
+    std::vector<std::uint32_t> open; // arrays that haven't ended yet
+
+    void push(coordinate_token token) {
+        if (!open.empty())
+            ++tokens[open.back()].size;
+        token.end = std::uint32_t(tokens.size() + 1);
+        tokens.push_back(token);
+    }
+
+    void startArray() {
+        push({ 0, 0, 0, coordinate_token::array });
+        open.push_back(std::uint32_t(tokens.size() - 1));
+    }
+
+    void endArray() {
+        tokens[open.back()].end = std::uint32_t(tokens.size());
+        open.pop_back();
+    }
+};
+
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Reads a number into the same double rapidjson::Reader produces without kParseFullPrecisionFlag, by
+// the same arithmetic: the digits are accumulated as an integer, converted, and divided by a power of
+// ten. Only forms where that arithmetic is simple are accepted, which covers coordinates written by
+// most tools: up to 9 integer digits, no exponent, and a significand that fits the 53 bits the reader
+// accumulates before switching to floating point. Returns false for anything else, consuming nothing.
+inline bool scanNumber(const char *&position, const char *end, double &result) {
+#if RAPIDJSON_64BIT
+    static constexpr double powers[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    constexpr std::uint64_t maxSignificand = (std::uint64_t(1) << 53) - 1;
+
+    const char *p    = position;
+    const bool minus = p != end && *p == '-';
+    if (minus)
+        ++p;
+    if (p == end || !isDigit(*p))
+        return false;
+
+    std::uint64_t significand = 0;
+    if (*p == '0') {
+        ++p;
+    } else {
+        const char *first = p;
+        for (; p != end && isDigit(*p); ++p) {
+            if (p - first == 9)
+                return false;
+            significand = significand * 10 + std::uint64_t(*p - '0');
+        }
+    }
+
+    if (p != end && *p == '.') {
+        ++p;
+        if (p == end || !isDigit(*p))
+            return false;
+
+        std::size_t decimals = 0;
+        for (; p != end && isDigit(*p); ++p, ++decimals) {
+            if (significand > maxSignificand || decimals == 22)
+                return false;
+            significand = significand * 10 + std::uint64_t(*p - '0');
+        }
+        if (p != end && (*p == 'e' || *p == 'E'))
+            return false;
+
+        const double d = double(significand) / powers[decimals];
+        result         = minus ? -d : d;
+    } else {
+        if (p != end && (*p == 'e' || *p == 'E'))
+            return false;
+
+        // Integers are reported through Int() or Uint(), which have no negative zero.
+        result = minus && significand ? -double(significand) : double(significand);
+    }
+
+    position = p;
+    return true;
+#else
+    (void)position;
+    (void)end;
+    (void)result;
+    return false;
+#endif
+}
+
+// Reads a "coordinates" array whose '[' the reader has just consumed, up to its closing bracket, which
+// is left for the reader to end the array with. At anything but nested arrays of numbers scanNumber()
+// accepts, it hands over to the reader before the top-level element containing it, keeping the tokens
+// of the elements before, so that the reader tokenizes the rest itself and reports errors at the
+// offsets it always would.
+inline void scanCoordinates(const char *&position, const char *end, reader_coordinates &coordinates) {
+    const char *resume       = position;
+    std::size_t resumeTokens = coordinates.tokens.size();
+    std::uint32_t resumeSize = coordinates.tokens[0].size;
+    const auto handOver      = [&] {
+        coordinates.tokens.resize(resumeTokens);
+        coordinates.tokens[0].size = resumeSize;
+        coordinates.open.resize(1);
+        position = resume;
+    };
+
+    const char *p   = position;
+    bool afterValue = false;
+    bool afterComma = false;
+    for (;;) {
+        while (p != end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+            ++p;
+        if (p == end)
+            return handOver();
+
+        if (coordinates.open.size() == 1 && !afterValue && *p != ']') {
+            resume       = p;
+            resumeTokens = coordinates.tokens.size();
+            resumeSize   = coordinates.tokens[0].size;
+        }
+
+        if (*p == ']') {
+            if (afterComma)
+                return handOver();
+            if (coordinates.open.size() == 1) {
+                position = p;
+                return;
+            }
+            coordinates.endArray();
+            ++p;
+            afterValue = true;
+        } else if (afterValue) {
+            if (*p != ',')
+                return handOver();
+            ++p;
+            afterValue = false;
+            afterComma = true;
+        } else if (*p == '[') {
+            coordinates.startArray();
+            ++p;
+            afterComma = false;
+        } else {
+            double number;
+            if (!scanNumber(p, end, number))
+                return handOver();
+            coordinates.push({ number, 0, 0, coordinate_token::number });
+            afterValue = true;
+            afterComma = false;
+        }
+    }
+}
+
+// Passes over a number without reading it, for forms rapidjson::Reader accepts whatever their digits:
+// up to 18 integer digits, which always fit 64 bits, any number of decimals, and no exponent, which could
+// make the number too big for a double.
+inline bool skipNumber(const char *&position, const char *end) {
+    const char *p = position;
+    if (p != end && *p == '-')
+        ++p;
+    if (p == end || !isDigit(*p))
+        return false;
+
+    if (*p == '0') {
+        ++p;
+    } else {
+        for (const char *first = p; p != end && isDigit(*p); ++p) {
+            if (p - first == 18)
+                return false;
+        }
+    }
+
+    if (p != end && *p == '.') {
+        ++p;
+        if (p == end || !isDigit(*p))
+            return false;
+        while (p != end && isDigit(*p))
+            ++p;
+    }
+    if (p != end && (*p == 'e' || *p == 'E'))
+        return false;
+
+    position = p;
+    return true;
+}
+
+// Like scanCoordinates(), but only passes over the nested arrays of numbers, for values that are skipped.
+// Returns whether it got to the closing bracket rather than handing over to the reader.
+inline bool skipArrays(const char *&position, const char *end) {
+    const char *resume  = position;
+    const auto handOver = [&] {
+        position = resume;
+        return false;
+    };
+
+    const char *p     = position;
+    std::size_t depth = 1;
+    bool afterValue   = false;
+    bool afterComma   = false;
+    for (;;) {
+        while (p != end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+            ++p;
+        if (p == end)
+            return handOver();
+
+        if (depth == 1 && !afterValue && *p != ']')
+            resume = p;
+
+        if (*p == ']') {
+            if (afterComma)
+                return handOver();
+            if (depth == 1) {
+                position = p;
+                return true;
+            }
+            --depth;
+            ++p;
+            afterValue = true;
+        } else if (afterValue) {
+            if (*p != ',')
+                return handOver();
+            ++p;
+            afterValue = false;
+            afterComma = true;
+        } else if (*p == '[') {
+            ++depth;
+            ++p;
+            afterComma = false;
+        } else {
+            if (!skipNumber(p, end))
+                return handOver();
+            afterValue = true;
+            afterComma = false;
+        }
+    }
+}
+
+template <class Types>
+struct reader_array {
+    typename Types::value::array_type values;
+};
+
+template <class Types>
+struct reader_map {
+    typename Types::prop_map values;
+    typename Types::key_string key;
+    const property_filter *filter = nullptr; // set for the properties of a feature that are filtered
+    bool skipping                 = false;   // whether the value of the current key is left out
+};
+
+// A "bbox" member, which is ignored unless it is an array of 4 or 6 numbers.
+struct reader_bbox {
+    std::vector<double> values;
+    bool numbers = true;
+
+    std::optional<box> bounds() const {
+        if (!numbers || (values.size() != 4 && values.size() != 6))
+            return std::nullopt;
+        const std::size_t dimensions = values.size() / 2;
+        return box({ values[0], values[1] }, { values[dimensions], values[dimensions + 1] });
+    }
+};
+
+struct reader_skip {
+    std::size_t depth = 1;
+    bool scans        = true; // cleared once skipArrays() handed over, so that nothing is scanned twice
+};
+
+// The "features" array of a FeatureCollection whose features are handed to a feature_callback.
+struct reader_stream {};
+
+template <class Types>
+using reader_frame = std::variant<reader_object<Types>,
+                                  deferred<typename Types::feature_collection>,
+                                  deferred<typename Types::geometry_collection>,
+                                  reader_coordinates,
+                                  reader_array<Types>,
+                                  reader_map<Types>,
+                                  reader_bbox,
+                                  reader_skip,
+                                  reader_stream>;
+
+template <class R, class Read>
+deferred<R> attempt(Read &&read) {
+    try {
+        return { read(), {} };
+    } catch (const error &e) {
+        return { R{}, e.what() };
+    }
+}
+
+template <class Types, class Position, class Clock>
+typename Types::geometry readGeometry(reader_object<Types> &object,
+                                      const Position &position,
+                                      const typename Types::allocator_type &allocator,
+                                      const Clock &clock) {
+    if (!object.type)
+        throw error("Geometry must have a type property");
+
+    const auto &type = *object.type;
+
+    if (type == "GeometryCollection") {
+        if (!object.geometries)
+            throw error("GeometryCollection must have a geometries property");
+
+        return typename Types::geometry{ object.geometries->take() };
+    }
+
+    if (!object.coordinates)
+        throw error(type + " geometry must have a coordinates property");
+
+    const coordinates_view json_coords(*object.coordinates);
+    if (!json_coords.IsArray())
+        throw error("coordinates property must be an array");
+
+    return convertGeometry<Types>(type, json_coords, position, allocator, clock);
+}
+
+template <class Types>
+typename Types::feature readFeature(reader_object<Types> &object) {
+    if (!object.type)
+        throw error("Feature must have a type property");
+    if (*object.type != "Feature")
+        throw error("Feature type must be Feature");
+
+    if (!object.geom)
+        throw error("Feature must have a geometry property");
+
+    auto geom       = object.geom->take();
+    auto id         = object.id ? object.id->take() : typename Types::identifier{};
+    auto properties = object.properties ? object.properties->take() : typename Types::prop_map{};
+
+    return Types::makeFeature(std::move(geom), std::move(properties), std::move(id));
+}
+
+template <class Types, class Position, class Clock>
+typename Types::geojson readGeoJSON(reader_object<Types> &object,
+                                    const Position &position,
+                                    const typename Types::allocator_type &allocator,
+                                    const Clock &clock) {
+    if (!object.type)
+        throw error("GeoJSON must have a type property");
+
+    const auto &type = *object.type;
+
+    if (type == "FeatureCollection") {
+        if (!object.features)
+            throw error("FeatureCollection must have features property");
+
+        return typename Types::geojson{ object.features->take() };
+    }
+
+    if (type == "Feature")
+        return typename Types::geojson{ readFeature(object) };
+
+    return typename Types::geojson{ readGeometry(object, position, allocator, clock) };
+}
+
+// The type family a parse into T produces.
+template <class T>
+struct reader_types {
+    using type = basic_types<coordinate_type_t<T>>;
+};
+
+template <>
+struct reader_types<pmr::geojson> {
+    using type = pmr_types;
+};
+
+template <>
+struct reader_types<pmr::geometry> {
+    using type = pmr_types;
+};
+
+template <>
+struct reader_types<pmr::feature> {
+    using type = pmr_types;
+};
+
+template <>
+struct reader_types<pmr::feature_collection> {
+    using type = pmr_types;
+};
+
+template <>
+struct reader_types<interned::geojson> {
+    using type = interned_types;
+};
+
+template <>
+struct reader_types<interned::feature> {
+    using type = interned_types;
+};
+
+template <>
+struct reader_types<interned::feature_collection> {
+    using type = interned_types;
+};
+
+template <>
+struct reader_types<flat::geojson> {
+    using type = flat_types;
+};
+
+template <>
+struct reader_types<flat::feature> {
+    using type = flat_types;
+};
+
+template <>
+struct reader_types<flat::feature_collection> {
+    using type = flat_types;
+};
+
+// rapidjson SAX handler converting GeoJSON while it is tokenized, without building a document first.
+// It accepts and rejects the same inputs, with the same messages, as convert<T>(const rapidjson_value &).
+// T may be of any coordinate type, or a pmr, interned, or flat type; the GeoJSON types below are those of
+// T's family. Validation is timed by the Clock, which only parse_with_stats() sets.
+template <class T, class Clock = no_validation_clock>
+class reader_handler {
+    using types               = typename reader_types<T>::type;
+    using coordinate_type     = typename types::coordinate_type;
+    using allocator_type      = typename types::allocator_type;
+    using geometry            = typename types::geometry;
+    using geometry_collection = typename types::geometry_collection;
+    using feature             = typename types::feature;
+    using feature_collection  = typename types::feature_collection;
+    using geojson             = typename types::geojson;
+    using value               = typename types::value;
+    using prop_map            = typename types::prop_map;
+    using identifier          = typename types::identifier;
+    using string              = typename types::string;
+    using object_frame        = reader_object<types>;
+
+public:
+    reader_handler() = default;
+
+    explicit reader_handler(coordinate_transform<coordinate_type> transform) : position(std::move(transform)) {
+    }
+
+    // Every string and container of the result is allocated from the memory resource.
+    explicit reader_handler(std::pmr::memory_resource *resource) : allocator(resource) {
+    }
+
+    // Every string of the result is stored in the table. Interned results read without a table refer to
+    // the strings of the input instead, which only in-situ parses leave in place.
+    explicit reader_handler(string_table &strings) : allocator(&strings) {
+    }
+
+    // Features of a top-level FeatureCollection are passed to the callback as soon as they are read,
+    // and the first invalid one is thrown right away.
+    explicit reader_handler(std::function<void(feature &&)> callback) : onFeature(std::move(callback)) {
+    }
+
+    // Lets the handler read the numbers of "coordinates" arrays straight from the input the reader is
+    // tokenizing, which then continues after them. Only valid for the reader's default number parsing.
+    void scanFrom(const char **position, const char *end) {
+        cursor    = position;
+        cursorEnd = end;
+    }
+
+    // Only the properties the filter keeps are read; the values of the others are tokenized but skipped.
+    // The filter must outlive the handler.
+    void filterProperties(const property_filter &filter) {
+        propertyFilter = filter.mode == property_mode::all ? nullptr : &filter;
+    }
+
+    // The "geometry" members of features are tokenized but skipped, and features get empty geometries.
+    void skipGeometries() {
+        geometries = false;
+    }
+
+    // Applies the options parse() takes. They must outlive the handler.
+    void applyOptions(const parse_options &options) {
+        filterProperties(options.properties);
+        if (!options.geometries)
+            skipGeometries();
+    }
+
+    // Reads "bbox" members, and records the bounding boxes of the root and of the features of a
+    // FeatureCollection in boxes, which must outlive the handler.
+    void collectBoxes(bounding_boxes &boxes) {
+        collected = &boxes;
+    }
+
+    // Times the validation of coordinates with the clock.
+    void timeValidation(const Clock &validation) {
+        clock = validation;
+    }
+
+    bool Null() {
+        return scalar(null_value_t{});
+    }
+
+    bool Bool(bool b) {
+        return scalar(b);
+    }
+
+    bool Int(int i) {
+        return Int64(i);
+    }
+
+    bool Uint(unsigned u) {
+        return Uint64(u);
+    }
+
+    // Matches GenericValue, which reports every non-negative integer as IsUint64().
+    bool Int64(std::int64_t i) {
+        return i < 0 ? scalar(i) : scalar(std::uint64_t(i));
+    }
+
+    bool Uint64(std::uint64_t u) {
+        return scalar(u);
+    }
+
+    bool Double(double d) {
+        return scalar(d);
+    }
+
+    // Only called with kParseNumbersAsStringsFlag, which isn't used.
+    bool RawNumber(const char *, rapidjson::SizeType, bool) {
+        return false;
+    }
+
+    bool String(const char *str, rapidjson::SizeType length, bool) {
+        return scalar(std::string_view(str, length));
+    }
+
+    bool StartObject() {
+        if (!stack.empty()) {
+            auto &frame = stack.back();
+            if (auto *skip = std::get_if<reader_skip>(&frame)) {
+                ++skip->depth;
+                return true;
+            }
+            if (auto *coordinates = std::get_if<reader_coordinates>(&frame)) {
+                coordinates->push({ 0, 0, 0, coordinate_token::other });
+                stack.emplace_back(reader_skip{});
+                return true;
+            }
+            if (auto *bbox = std::get_if<reader_bbox>(&frame)) {
+                bbox->numbers = false;
+                stack.emplace_back(reader_skip{});
+                return true;
+            }
+        }
+
+        const auto slot = expect();
+        switch (slot) {
+        case reader_slot::geojson:
+        case reader_slot::geometry:
+        case reader_slot::feature:
+            stack.emplace_back(object_frame(slot));
+            break;
+        case reader_slot::properties:
+            stack.emplace_back(reader_map<types>{ construct<prop_map>(allocator), {}, propertyFilter });
+            break;
+        case reader_slot::value:
+            stack.emplace_back(reader_map<types>{ construct<prop_map>(allocator), {} });
+            break;
+        default:
+            reject(slot);
+            stack.emplace_back(reader_skip{});
+            break;
+        }
+        return true;
+    }
+
+    bool Key(const char *str, rapidjson::SizeType length, bool) {
+        auto &frame = stack.back();
+        if (auto *object = std::get_if<object_frame>(&frame)) {
+            object->member = memberSlot(*object, std::string_view(str, length));
+            if (object->member == reader_slot::geometry && !geometries) {
+                object->geom   = deferred<geometry>{ empty{}, {} };
+                object->member = reader_slot::skip;
+            }
+        } else if (auto *map = std::get_if<reader_map<types>>(&frame)) {
+            map->skipping = map->filter && !map->filter->keeps(std::string_view(str, length));
+            if (!map->skipping)
+                map->key = types::makeKey(std::string_view(str, length), allocator);
+        }
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+        auto &frame = stack.back();
+        if (auto *skip = std::get_if<reader_skip>(&frame)) {
+            if (--skip->depth == 0)
+                stack.pop_back();
+            return true;
+        }
+
+        if (auto *map = std::get_if<reader_map<types>>(&frame)) {
+            prop_map values = std::move(map->values);
+            stack.pop_back();
+            types::closeObject(values);
+            if (std::holds_alternative<object_frame>(stack.back())) {
+                deliver(deferred<prop_map>{ std::move(values), {} });
+            } else {
+                deliver(types::makeObject(std::move(values)));
+            }
+            return true;
+        }
+
+        object_frame object = std::move(std::get<object_frame>(frame));
+        stack.pop_back();
+
+        extent bounds; // of the object's own coordinates
+        if (collected)
+            position.measure(&bounds);
+        switch (object.role) {
+        case reader_slot::geometry:
+            deliver(attempt<geometry>([&] { return readGeometry(object, position, allocator, clock); }));
+            break;
+        case reader_slot::feature:
+            deliver(attempt<feature>([&] { return readFeature(object); }));
+            break;
+        default:
+            deliver(attempt<geojson>([&] { return readGeoJSON(object, position, allocator, clock); }));
+            break;
+        }
+        if (collected) {
+            position.measure(nullptr);
+            recordBounds(object, bounds);
+        }
+        return true;
+    }
+
+    bool StartArray() {
+        if (!stack.empty()) {
+            auto &frame = stack.back();
+            if (auto *skip = std::get_if<reader_skip>(&frame)) {
+                ++skip->depth;
+                if (cursor && skip->scans)
+                    skip->scans = skipArrays(*cursor, cursorEnd);
+                return true;
+            }
+            if (auto *coordinates = std::get_if<reader_coordinates>(&frame)) {
+                coordinates->startArray();
+                return true;
+            }
+            if (auto *bbox = std::get_if<reader_bbox>(&frame)) {
+                bbox->numbers = false;
+                stack.emplace_back(reader_skip{});
+                return true;
+            }
+        }
+
+        const auto slot = expect();
+        switch (slot) {
+        case reader_slot::features:
+            if (onFeature && streams(std::get<object_frame>(stack.back()))) {
+                stack.emplace_back(reader_stream{});
+                break;
+            }
+            stack.emplace_back(deferred<feature_collection>{ construct<feature_collection>(allocator), {} });
+            break;
+        case reader_slot::collection:
+            stack.emplace_back(deferred<feature_collection>{ construct<feature_collection>(allocator), {} });
+            break;
+        case reader_slot::geometries:
+            stack.emplace_back(deferred<geometry_collection>{ construct<geometry_collection>(allocator), {} });
+            break;
+        case reader_slot::coordinates: {
+            reader_coordinates coordinates;
+            coordinates.startArray();
+            if (cursor)
+                scanCoordinates(*cursor, cursorEnd, coordinates);
+            stack.emplace_back(std::move(coordinates));
+            break;
+        }
+        case reader_slot::bbox:
+            stack.emplace_back(reader_bbox{});
+            break;
+        case reader_slot::value:
+            stack.emplace_back(reader_array<types>{ construct<typename value::array_type>(allocator) });
+            break;
+        default:
+            reject(slot);
+            stack.emplace_back(reader_skip{});
+            break;
+        }
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        auto &frame = stack.back();
+        if (auto *skip = std::get_if<reader_skip>(&frame)) {
+            if (--skip->depth == 0)
+                stack.pop_back();
+            return true;
+        }
+
+        if (auto *bbox = std::get_if<reader_bbox>(&frame)) {
+            const auto bounds = bbox->bounds();
+            stack.pop_back();
+            std::get<object_frame>(stack.back()).bbox = bounds;
+            return true;
+        }
+
+        if (auto *coordinates = std::get_if<reader_coordinates>(&frame)) {
+            coordinates->endArray();
+            if (coordinates->open.empty()) {
+                coordinates_buffer tokens = std::move(coordinates->tokens);
+                stack.pop_back();
+                std::get<object_frame>(stack.back()).coordinates = std::move(tokens);
+            }
+            return true;
+        }
+
+        if (auto *array = std::get_if<reader_array<types>>(&frame)) {
+            typename value::array_type values = std::move(array->values);
+            stack.pop_back();
+            deliver(value(std::move(values)));
+        } else if (std::holds_alternative<reader_stream>(frame)) {
+            stack.pop_back();
+            deliver(deferred<feature_collection>{});
+        } else if (auto *features = std::get_if<deferred<feature_collection>>(&frame)) {
+            deferred<feature_collection> result = std::move(*features);
+            stack.pop_back();
+            if (collected && stack.empty())
+                collected->root = rootBounds.bounds();
+            deliver(std::move(result));
+        } else {
+            deferred<geometry_collection> result = std::move(std::get<deferred<geometry_collection>>(frame));
+            stack.pop_back();
+            deliver(std::move(result));
+        }
+        return true;
+    }
+
+    // Only valid once the reader finished without a parse error.
+    T result() {
+        assert(root);
+        return root->take();
+    }
+
+private:
+    static constexpr reader_slot rootSlot() {
+        if constexpr (std::is_same_v<T, geojson>)
+            return reader_slot::geojson;
+        else if constexpr (std::is_same_v<T, geometry>)
+            return reader_slot::geometry;
+        else if constexpr (std::is_same_v<T, feature>)
+            return reader_slot::feature;
+        else
+            return reader_slot::collection;
+    }
+
+    // Only the first occurrence of a member is read, like rapidjson's FindMember() does.
+    reader_slot memberSlot(const object_frame &object, std::string_view key) const {
+        const bool geometryMembers = object.role != reader_slot::feature;
+        const bool featureMembers  = object.role != reader_slot::geometry;
+
+        if (key == "type")
+            return object.type ? reader_slot::skip : reader_slot::type;
+        if (geometryMembers && key == "coordinates")
+            return object.coordinates ? reader_slot::skip : reader_slot::coordinates;
+        if (geometryMembers && key == "geometries")
+            return object.geometries ? reader_slot::skip : reader_slot::geometries;
+        if (featureMembers && key == "geometry")
+            return object.geom ? reader_slot::skip : reader_slot::geometry;
+        if (featureMembers && key == "id")
+            return object.id ? reader_slot::skip : reader_slot::id;
+        if (featureMembers && key == "properties")
+            return object.properties ? reader_slot::skip : reader_slot::properties;
+        if (object.role == reader_slot::geojson && key == "features")
+            return object.features ? reader_slot::skip : reader_slot::features;
+        if (collected && key == "bbox")
+            return object.bbox ? reader_slot::skip : reader_slot::bbox;
+        return reader_slot::skip;
+    }
+
+    // Features are only streamed while the object may still turn out to be a FeatureCollection.
+    static bool streams(const object_frame &object) {
+        return object.role == reader_slot::geojson && (!object.type || *object.type == "FeatureCollection");
+    }
+
+    reader_slot expect() const {
+        if (stack.empty())
+            return rootSlot();
+
+        const auto &frame = stack.back();
+        if (const auto *object = std::get_if<object_frame>(&frame))
+            return object->member;
+        // Once an element failed, the remaining ones are only tokenized.
+        if (const auto *features = std::get_if<deferred<feature_collection>>(&frame))
+            return features->message.empty() ? reader_slot::feature : reader_slot::skip;
+        if (const auto *geometries = std::get_if<deferred<geometry_collection>>(&frame))
+            return geometries->message.empty() ? reader_slot::geometry : reader_slot::skip;
+        if (std::holds_alternative<reader_stream>(frame))
+            return reader_slot::feature;
+        if (std::holds_alternative<reader_skip>(frame))
+            return reader_slot::skip;
+        if (const auto *map = std::get_if<reader_map<types>>(&frame))
+            return map->skipping ? reader_slot::skip : reader_slot::value;
+        return reader_slot::value;
+    }
+
+    template <class Scalar>
+    bool scalar(Scalar s) {
+        if (!stack.empty()) {
+            if (auto *coordinates = std::get_if<reader_coordinates>(&stack.back())) {
+                if constexpr (std::is_arithmetic_v<Scalar> && !std::is_same_v<Scalar, bool>) {
+                    coordinates->push({ double(s), 0, 0, coordinate_token::number });
+                } else {
+                    coordinates->push({ 0, 0, 0, coordinate_token::other });
+                }
+                return true;
+            }
+            if (auto *bbox = std::get_if<reader_bbox>(&stack.back())) {
+                if constexpr (std::is_arithmetic_v<Scalar> && !std::is_same_v<Scalar, bool>) {
+                    bbox->values.push_back(double(s));
+                } else {
+                    bbox->numbers = false;
+                }
+                return true;
+            }
+        }
+
+        constexpr bool isNull   = std::is_same_v<Scalar, null_value_t>;
+        constexpr bool isString = std::is_same_v<Scalar, std::string_view>;
+        constexpr bool isNumber = std::is_arithmetic_v<Scalar> && !std::is_same_v<Scalar, bool>;
+
+        const auto slot = expect();
+        switch (slot) {
+        case reader_slot::value:
+            if constexpr (isString) {
+                deliver(value(construct<string>(allocator, s)));
+            } else {
+                deliver(value(s));
+            }
+            return true;
+        case reader_slot::type:
+            if constexpr (isString) {
+                deliverType(std::string(s));
+            } else {
+                deliverType({});
+            }
+            return true;
+        case reader_slot::id:
+            if constexpr (isString) {
+                deliver(deferred<identifier>{ identifier{ construct<string>(allocator, s) }, {} });
+                return true;
+            } else if constexpr (isNumber) {
+                deliver(deferred<identifier>{ identifier{ s }, {} });
+                return true;
+            }
+            break;
+        case reader_slot::geometry:
+            if constexpr (isNull) {
+                deliver(deferred<geometry>{ empty{}, {} });
+                return true;
+            }
+            break;
+        case reader_slot::properties:
+            if constexpr (isNull) {
+                deliver(deferred<prop_map>{});
+                return true;
+            }
+            break;
+        default:
+            break;
+        }
+
+        reject(slot);
+        return true;
+    }
+
+    // Records the outcome of a value whose JSON type doesn't fit the slot.
+    void reject(reader_slot slot) {
+        switch (slot) {
+        case reader_slot::geojson:
+            deliver(deferred<geojson>{ {}, "GeoJSON must be an object" });
+            break;
+        case reader_slot::geometry:
+            deliver(deferred<geometry>{ {}, "Geometry must be an object" });
+            break;
+        case reader_slot::feature:
+            deliver(deferred<feature>{ {}, "Feature must be an object" });
+            break;
+        case reader_slot::collection:
+            deliver(deferred<feature_collection>{
+                {},
+                "coordinates must be an array of points describing linestring or an array of "
+                "arrays describing polygons and line strings." });
+            break;
+        case reader_slot::features:
+            deliver(deferred<feature_collection>{ {}, "FeatureCollection features property must be an array" });
+            break;
+        case reader_slot::geometries:
+            deliver(deferred<geometry_collection>{ {}, "GeometryCollection geometries property must be an array" });
+            break;
+        case reader_slot::coordinates:
+            std::get<object_frame>(stack.back()).coordinates =
+                coordinates_buffer{ { 0, 0, 1, coordinate_token::other } };
+            break;
+        case reader_slot::type:
+            deliverType({});
+            break;
+        case reader_slot::id:
+            deliver(deferred<identifier>{ {}, "Feature id must be a string or number" });
+            break;
+        case reader_slot::properties:
+            deliver(deferred<prop_map>{ {}, "properties must be an object" });
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Records the bounding box of an object that ended with the object, collection, or result it's in.
+    void recordBounds(const object_frame &object, const extent &bounds) {
+        std::optional<box> result = object.bbox;
+        if (!result && object.type) {
+            const auto &type = *object.type;
+            if (type == "FeatureCollection") {
+                result = object.featuresBounds.bounds();
+            } else if (type == "GeometryCollection") {
+                result = object.geometriesBounds.bounds();
+            } else if (type == "Feature") {
+                result = object.geometryBounds.bounds();
+            } else {
+                result = bounds.bounds();
+            }
+        }
+
+        if (stack.empty()) {
+            collected->root = result;
+            if (!object.type || *object.type != "FeatureCollection")
+                collected->features.clear();
+        } else if (auto *owner = std::get_if<object_frame>(&stack.back())) {
+            owner->geometryBounds.extend(result);
+        } else if (stack.size() == 1) {
+            collected->features.push_back(result);
+            rootBounds.extend(result);
+        } else {
+            auto &collection = std::get<object_frame>(stack[stack.size() - 2]);
+            if (object.role == reader_slot::feature) {
+                collected->features.push_back(result);
+                collection.featuresBounds.extend(result);
+            } else {
+                collection.geometriesBounds.extend(result);
+            }
+        }
+    }
+
+    // A non-string type never matches any GeoJSON type name.
+    void deliverType(std::string type) {
+        std::get<object_frame>(stack.back()).type = std::move(type);
+    }
+
+    void deliver(value &&result) {
+        auto &frame = stack.back();
+        if (auto *array = std::get_if<reader_array<types>>(&frame)) {
+            array->values.push_back(std::move(result));
+        } else {
+            auto &map = std::get<reader_map<types>>(frame);
+            types::insert(map.values, std::move(map.key), std::move(result), allocator);
+        }
+    }
+
+    template <class R>
+    void deliver(deferred<R> &&result) {
+        if (stack.empty()) {
+            if constexpr (std::is_same_v<R, T>) {
+                root = std::move(result);
+            }
+            return;
+        }
+
+        auto &frame = stack.back();
+        if (auto *object = std::get_if<object_frame>(&frame)) {
+            if constexpr (std::is_same_v<R, geometry>) {
+                object->geom = std::move(result);
+            } else if constexpr (std::is_same_v<R, geometry_collection>) {
+                object->geometries = std::move(result);
+            } else if constexpr (std::is_same_v<R, feature_collection>) {
+                object->features = std::move(result);
+            } else if constexpr (std::is_same_v<R, identifier>) {
+                object->id = std::move(result);
+            } else if constexpr (std::is_same_v<R, prop_map>) {
+                object->properties = std::move(result);
+            }
+            return;
+        }
+
+        if constexpr (std::is_same_v<R, feature>) {
+            if (std::holds_alternative<reader_stream>(frame)) {
+                onFeature(result.take());
+                return;
+            }
+        }
+
+        if constexpr (std::is_same_v<R, feature> || std::is_same_v<R, geometry>) {
+            using Cont = std::conditional_t<std::is_same_v<R, feature>, feature_collection, geometry_collection>;
+            auto &collection = std::get<deferred<Cont>>(frame);
+            if (!result.message.empty()) {
+                collection.message = std::move(result.message);
+            } else {
+                collection.value.push_back(std::move(result.value));
+            }
+        }
+    }
+
+    std::vector<reader_frame<types>> stack;
+    std::optional<deferred<T>> root;
+    position_reader<coordinate_type> position;
+    allocator_type allocator{};
+    Clock clock;
+    const char **cursor   = nullptr;
+    const char *cursorEnd = nullptr;
+    std::function<void(feature &&)> onFeature;
+    const property_filter *propertyFilter = nullptr;
+    bool geometries                       = true;
+    bounding_boxes *collected             = nullptr;
+    extent rootBounds; // of the features of a top-level array, as read by parse<feature_collection>
+};
+
+template <unsigned parseFlags = rapidjson::kParseDefaultFlags, class T, class Clock, class Stream>
+T read(Stream &stream, reader_handler<T, Clock> &handler) {
+    rapidjson::Reader reader;
+    const rapidjson::ParseResult result = reader.Parse<parseFlags>(stream, handler);
+    if (result.IsError()) {
+        std::stringstream message;
+        message << result.Offset() << " - " << rapidjson::GetParseError_En(result.Code());
+        throw error(message.str());
+    }
+    return handler.result();
+}
+
+// A read-only stream over exactly length bytes, read like rapidjson::MemoryStream behind the UTF-8
+// EncodedInputStream that skips a byte order mark, with offsets counted from the start of the input. The
+// stream owns its cursor, so that reader_handler::scanFrom() can move it ahead without depending on the
+// members of a rapidjson stream.
+class memory_stream {
+public:
+    using Ch = char;
+
+    memory_stream(const char *json, std::size_t length) : src(json), head(json), tail(json + length) {
+        if (length >= 3 && std::memcmp(json, "\xEF\xBB\xBF", 3) == 0)
+            src += 3;
+    }
+
+    Ch Peek() const {
+        return src == tail ? '\0' : *src;
+    }
+
+    Ch Take() {
+        return src == tail ? '\0' : *src++;
+    }
+
+    std::size_t Tell() const {
+        return static_cast<std::size_t>(src - head);
+    }
+
+    // Only insitu parsing writes to the stream.
+    Ch *PutBegin() {
+        assert(false);
+        return nullptr;
+    }
+
+    void Put(Ch) {
+        assert(false);
+    }
+
+    void Flush() {
+        assert(false);
+    }
+
+    std::size_t PutEnd(Ch *) {
+        assert(false);
+        return 0;
+    }
+
+    // The unread input, for reader_handler::scanFrom().
+    const char **cursor() {
+        return &src;
+    }
+
+    const char *end() const {
+        return tail;
+    }
+
+private:
+    const char *src;
+    const char *head;
+    const char *tail;
+};
+
+// Reads exactly length bytes like the length-aware Document::Parse(), so the input needs neither to be
+// owned nor NUL terminated.
+template <class T, class Clock>
+T read(const char *json, std::size_t length, reader_handler<T, Clock> &handler) {
+    memory_stream stream(json, length);
+    handler.scanFrom(stream.cursor(), stream.end());
+    return read(stream, handler);
+}
+
+template <class T>
+T parse_rapidjson(std::string_view json,
+                  const parse_options &options,
+                  const coordinate_transform<coordinate_type_t<T>> &transform) {
+    reader_handler<T> handler(transform);
+    handler.applyOptions(options);
+    return read(json.data(), json.size(), handler);
+}
+
+template <class T>
+T parse_rapidjson(std::string_view json, const coordinate_transform<coordinate_type_t<T>> &transform) {
+    return parse_rapidjson<T>(json, parse_options{}, transform);
+}
+
+#if defined(GEOJSON_SIMDJSON)
+
+static_assert(parse_padding >= simdjson::SIMDJSON_PADDING, "parse_padding must cover simdjson's padding");
+
+// Parsers and copies of the input larger than this, in bytes of input, aren't kept for the next parse.
+constexpr std::size_t simdjsonRetainedCapacity = 1 << 20;
+
+// A simdjson parser, and a copy of the input followed by the padding simdjson reads past its end for
+// input that has none. Each thread keeps one, unless a coordinate transform parses while it is in use,
+// and releases what grew beyond simdjsonRetainedCapacity after each parse.
+struct simdjson_workspace {
+    simdjson::ondemand::parser parser;
+    std::vector<char> input;
+    bool busy = false;
+
+    void trim() {
+        if (input.capacity() > simdjsonRetainedCapacity)
+            std::vector<char>().swap(input);
+        if (parser.capacity() > simdjsonRetainedCapacity)
+            parser = simdjson::ondemand::parser();
+    }
+};
+
+class simdjson_lease {
+public:
+    simdjson_lease() {
+        thread_local simdjson_workspace shared;
+        if (shared.busy)
+            nested = std::make_unique<simdjson_workspace>();
+        workspace       = nested ? nested.get() : &shared;
+        workspace->busy = true;
+    }
+
+    simdjson_lease(const simdjson_lease &)            = delete;
+    simdjson_lease &operator=(const simdjson_lease &) = delete;
+
+    ~simdjson_lease() {
+        workspace->trim();
+        workspace->busy = false;
+    }
+
+    simdjson_workspace *operator->() const {
+        return workspace;
+    }
+
+private:
+    std::unique_ptr<simdjson_workspace> nested;
+    simdjson_workspace *workspace;
+};
+
+// Integers are taken from simdjson, exactly. Other numbers are read the way rapidjson::Reader reads them
+// by default, which isn't always correctly rounded like simdjson: by scanNumber() where it applies, and
+// by the reader itself otherwise.
+template <class Handler>
+bool readSimdjsonNumber(simdjson::ondemand::value &element, Handler &handler) {
+    using simdjson::ondemand::number_type;
+
+    number_type type;
+    if (element.get_number_type().get(type))
+        return false;
+    if (type == number_type::signed_integer) {
+        std::int64_t i;
+        return !element.get_int64().get(i) && handler.Int64(i);
+    }
+    if (type == number_type::unsigned_integer) {
+        std::uint64_t u;
+        return !element.get_uint64().get(u) && handler.Uint64(u);
+    }
+
+    std::string_view token = element.raw_json_token();
+    while (!token.empty() && (token.back() == ' ' || token.back() == '\n' || token.back() == '\r' ||
+                              token.back() == '\t'))
+        token.remove_suffix(1);
+
+    const char *position = token.data();
+    const char *end      = token.data() + token.size();
+    double d;
+    if (scanNumber(position, end, d) && position == end)
+        return handler.Double(d);
+
+    rapidjson::MemoryStream stream(token.data(), token.size());
+    rapidjson::Reader reader;
+    return !reader.Parse(stream, handler).IsError();
+}
+
+// Passes a value to the handler as the events rapidjson::Reader produces for it. Returns false at
+// anything simdjson rejects.
+template <class Handler>
+bool walkSimdjson(simdjson::ondemand::value &element, Handler &handler) {
+    using simdjson::ondemand::json_type;
+
+    json_type type;
+    if (element.type().get(type))
+        return false;
+
+    switch (type) {
+    case json_type::array: {
+        simdjson::ondemand::array array;
+        if (element.get_array().get(array))
+            return false;
+        handler.StartArray();
+        rapidjson::SizeType count = 0;
+        for (auto item : array) {
+            simdjson::ondemand::value child;
+            if (item.get(child) || !walkSimdjson(child, handler))
+                return false;
+            ++count;
+        }
+        return handler.EndArray(count);
+    }
+    case json_type::object: {
+        simdjson::ondemand::object object;
+        if (element.get_object().get(object))
+            return false;
+        handler.StartObject();
+        rapidjson::SizeType count = 0;
+        for (auto item : object) {
+            simdjson::ondemand::field member;
+            std::string_view key;
+            if (item.get(member) || member.unescaped_key().get(key))
+                return false;
+            handler.Key(key.data(), rapidjson::SizeType(key.size()), true);
+            if (!walkSimdjson(member.value(), handler))
+                return false;
+            ++count;
+        }
+        return handler.EndObject(count);
+    }
+    case json_type::number:
+        return readSimdjsonNumber(element, handler);
+    case json_type::string: {
+        std::string_view string;
+        return !element.get_string().get(string) &&
+               handler.String(string.data(), rapidjson::SizeType(string.size()), true);
+    }
+    case json_type::boolean: {
+        bool b;
+        return !element.get_bool().get(b) && handler.Bool(b);
+    }
+    case json_type::null: {
+        bool null;
+        return !element.is_null().get(null) && null && handler.Null();
+    }
+    default:
+        return false;
+    }
+}
+
+// Tokenizes the input with simdjson's On Demand API, feeding the handler the same events as read().
+// capacity bytes are readable from the start of the input; unless that leaves simdjson's padding past its
+// end, the input is copied first. Returns false for input simdjson rejects, and for scalar documents,
+// which On Demand doesn't expose as values, leaving the handler in an unspecified state.
+template <class T>
+bool readSimdjson(std::string_view json, std::size_t capacity, reader_handler<T> &handler) {
+    using simdjson::ondemand::json_type;
+
+    simdjson_lease workspace;
+    const char *input = json.data();
+    if (capacity < json.size() + simdjson::SIMDJSON_PADDING) {
+        capacity = json.size() + simdjson::SIMDJSON_PADDING;
+        if (workspace->input.size() < capacity)
+            workspace->input.resize(capacity);
+        if (!json.empty())
+            std::memcpy(workspace->input.data(), json.data(), json.size());
+        std::memset(workspace->input.data() + json.size(), 0, simdjson::SIMDJSON_PADDING);
+        input = workspace->input.data();
+    }
+
+    simdjson::ondemand::document document;
+    json_type type;
+    simdjson::ondemand::value root;
+    if (workspace->parser.iterate(simdjson::padded_string_view(input, json.size(), capacity)).get(document) ||
+        document.type().get(type) || (type != json_type::array && type != json_type::object) ||
+        document.get_value().get(root))
+        return false;
+
+    return walkSimdjson(root, handler) && document.at_end();
+}
+
+template <class T>
+T parseSimdjson(std::string_view json,
+                std::size_t capacity,
+                const parse_options &options,
+                const coordinate_transform<coordinate_type_t<T>> &transform) {
+    {
+        reader_handler<T> handler(transform);
+        handler.applyOptions(options);
+        if (readSimdjson(json, capacity, handler))
+            return handler.result();
+    }
+    // Whatever simdjson doesn't accept is left to rapidjson, which either reads it, like invalid UTF-8 or
+    // integers beyond 64 bits, or rejects it with its own message and offset.
+    return parse_rapidjson<T>(json, options, transform);
+}
+
+template <class T>
+T parse_simdjson(std::string_view json,
+                 const parse_options &options,
+                 const coordinate_transform<coordinate_type_t<T>> &transform) {
+    return parseSimdjson<T>(json, json.size(), options, transform);
+}
+
+template <class T>
+T parse_simdjson(std::string_view json, const coordinate_transform<coordinate_type_t<T>> &transform) {
+    return parse_simdjson<T>(json, parse_options{}, transform);
+}
+
+#endif
+
+template <class T>
+T parse(const char *json, std::size_t length, const coordinate_transform<coordinate_type_t<T>> &transform) {
+#if defined(GEOJSON_SIMDJSON)
+    return parse_simdjson<T>(std::string_view(json, length), transform);
+#else
+    return parse_rapidjson<T>(std::string_view(json, length), transform);
+#endif
+}
+
+template <class T>
+T parse(std::string_view json, const coordinate_transform<coordinate_type_t<T>> &transform) {
+    return parse<T>(json.data(), json.size(), transform);
+}
+
+template <class T>
+T parse(std::string_view json,
+        const parse_options &options,
+        const coordinate_transform<coordinate_type_t<T>> &transform) {
+#if defined(GEOJSON_SIMDJSON)
+    return parse_simdjson<T>(json, options, transform);
+#else
+    return parse_rapidjson<T>(json, options, transform);
+#endif
+}
+
+template <class T>
+T parse_padded(std::string_view json, std::size_t capacity) {
+#if defined(GEOJSON_SIMDJSON)
+    return parseSimdjson<T>(json, capacity, parse_options{}, {});
+#else
+    static_cast<void>(capacity);
+    return parse_rapidjson<T>(json);
+#endif
+}
+
+// Instantiate the template.
+template geojson parse_padded<geojson>(std::string_view, std::size_t);
+template geometry parse_padded<geometry>(std::string_view, std::size_t);
+template feature parse_padded<feature>(std::string_view, std::size_t);
+template feature_collection parse_padded<feature_collection>(std::string_view, std::size_t);
+
+// Specialized implementation for geojson.
+geojson parse_padded(std::string_view json, std::size_t capacity) {
+    return parse_padded<geojson>(json, capacity);
+}
+
+// Instantiate the template.
+template <class CoordT>
+using transform_ref = const coordinate_transform<CoordT> &;
+
+template geojson parse<geojson>(std::string_view, transform_ref<double>);
+template geometry parse<geometry>(std::string_view, transform_ref<double>);
+template feature parse<feature>(std::string_view, transform_ref<double>);
+template feature_collection parse<feature_collection>(std::string_view, transform_ref<double>);
+
+template geojson parse<geojson>(const char *, std::size_t, transform_ref<double>);
+template geometry parse<geometry>(const char *, std::size_t, transform_ref<double>);
+template feature parse<feature>(const char *, std::size_t, transform_ref<double>);
+template feature_collection parse<feature_collection>(const char *, std::size_t, transform_ref<double>);
+
+template geojson parse<geojson>(std::string_view, const parse_options &, transform_ref<double>);
+template geometry parse<geometry>(std::string_view, const parse_options &, transform_ref<double>);
+template feature parse<feature>(std::string_view, const parse_options &, transform_ref<double>);
+template feature_collection parse<feature_collection>(std::string_view, const parse_options &, transform_ref<double>);
+
+// Instantiate the template for the other coordinate types.
+template basic_geojson<float> parse(std::string_view, transform_ref<float>);
+template maplibre::geometry::geometry<float> parse(std::string_view, transform_ref<float>);
+template maplibre::feature::feature<float> parse(std::string_view, transform_ref<float>);
+template maplibre::feature::feature_collection<float> parse(std::string_view, transform_ref<float>);
+template basic_geojson<float> parse(const char *, std::size_t, transform_ref<float>);
+template maplibre::geometry::geometry<float> parse(const char *, std::size_t, transform_ref<float>);
+template maplibre::feature::feature<float> parse(const char *, std::size_t, transform_ref<float>);
+template maplibre::feature::feature_collection<float> parse(const char *, std::size_t, transform_ref<float>);
+template basic_geojson<float> parse(std::string_view, const parse_options &, transform_ref<float>);
+template maplibre::geometry::geometry<float> parse(std::string_view, const parse_options &, transform_ref<float>);
+template maplibre::feature::feature<float> parse(std::string_view, const parse_options &, transform_ref<float>);
+template maplibre::feature::feature_collection<float>
+parse(std::string_view, const parse_options &, transform_ref<float>);
+
+template basic_geojson<std::int32_t> parse(std::string_view, transform_ref<std::int32_t>);
+template maplibre::geometry::geometry<std::int32_t> parse(std::string_view, transform_ref<std::int32_t>);
+template maplibre::feature::feature<std::int32_t> parse(std::string_view, transform_ref<std::int32_t>);
+template maplibre::feature::feature_collection<std::int32_t> parse(std::string_view, transform_ref<std::int32_t>);
+template basic_geojson<std::int32_t> parse(const char *, std::size_t, transform_ref<std::int32_t>);
+template maplibre::geometry::geometry<std::int32_t> parse(const char *, std::size_t, transform_ref<std::int32_t>);
+template maplibre::feature::feature<std::int32_t> parse(const char *, std::size_t, transform_ref<std::int32_t>);
+template maplibre::feature::feature_collection<std::int32_t>
+parse(const char *, std::size_t, transform_ref<std::int32_t>);
+template basic_geojson<std::int32_t> parse(std::string_view, const parse_options &, transform_ref<std::int32_t>);
+template maplibre::geometry::geometry<std::int32_t>
+parse(std::string_view, const parse_options &, transform_ref<std::int32_t>);
+template maplibre::feature::feature<std::int32_t>
+parse(std::string_view, const parse_options &, transform_ref<std::int32_t>);
+template maplibre::feature::feature_collection<std::int32_t>
+parse(std::string_view, const parse_options &, transform_ref<std::int32_t>);
+
+template basic_geojson<std::int16_t> parse(std::string_view, transform_ref<std::int16_t>);
+template maplibre::geometry::geometry<std::int16_t> parse(std::string_view, transform_ref<std::int16_t>);
+template maplibre::feature::feature<std::int16_t> parse(std::string_view, transform_ref<std::int16_t>);
+template maplibre::feature::feature_collection<std::int16_t> parse(std::string_view, transform_ref<std::int16_t>);
+template basic_geojson<std::int16_t> parse(const char *, std::size_t, transform_ref<std::int16_t>);
+template maplibre::geometry::geometry<std::int16_t> parse(const char *, std::size_t, transform_ref<std::int16_t>);
+template maplibre::feature::feature<std::int16_t> parse(const char *, std::size_t, transform_ref<std::int16_t>);
+template maplibre::feature::feature_collection<std::int16_t>
+parse(const char *, std::size_t, transform_ref<std::int16_t>);
+template basic_geojson<std::int16_t> parse(std::string_view, const parse_options &, transform_ref<std::int16_t>);
+template maplibre::geometry::geometry<std::int16_t>
+parse(std::string_view, const parse_options &, transform_ref<std::int16_t>);
+template maplibre::feature::feature<std::int16_t>
+parse(std::string_view, const parse_options &, transform_ref<std::int16_t>);
+template maplibre::feature::feature_collection<std::int16_t>
+parse(std::string_view, const parse_options &, transform_ref<std::int16_t>);
+
+// Specialized implementation for geojson.
+geojson parse(std::string_view json) {
+    return parse<geojson>(json);
+}
+
+geojson parse(const char *json, std::size_t length) {
+    return parse<geojson>(json, length);
+}
+
+geojson parse(std::string_view json, const parse_options &options) {
+    return parse<geojson>(json, options);
+}
+
+// Instantiate the template.
+template geojson parse_rapidjson<geojson>(std::string_view, transform_ref<double>);
+template geometry parse_rapidjson<geometry>(std::string_view, transform_ref<double>);
+template feature parse_rapidjson<feature>(std::string_view, transform_ref<double>);
+template feature_collection parse_rapidjson<feature_collection>(std::string_view, transform_ref<double>);
+template geojson parse_rapidjson<geojson>(std::string_view, const parse_options &, transform_ref<double>);
+template geometry parse_rapidjson<geometry>(std::string_view, const parse_options &, transform_ref<double>);
+template feature parse_rapidjson<feature>(std::string_view, const parse_options &, transform_ref<double>);
+template feature_collection
+parse_rapidjson<feature_collection>(std::string_view, const parse_options &, transform_ref<double>);
+
+// Specialized implementation for geojson.
+geojson parse_rapidjson(std::string_view json) {
+    return parse_rapidjson<geojson>(json);
+}
+
+geojson parse_rapidjson(std::string_view json, const parse_options &options) {
+    return parse_rapidjson<geojson>(json, options);
+}
+
+// A pool document is read by passing its values through the reader's handler, which accepts and rejects
+// the same inputs as convert<T>(const rapidjson_value &), rather than by a second copy of the converters.
+template <typename T>
+T convert(const rapidjson_pool_value &json, const convert_options &options) {
+    const parse_options parseOptions{ options.properties, options.geometries };
+    reader_handler<T> handler;
+    handler.applyOptions(parseOptions);
+    json.Accept(handler);
+    return handler.result();
+}
+
+// Instantiate the template.
+template geojson convert<geojson>(const rapidjson_pool_value &, const convert_options &);
+template geometry convert<geometry>(const rapidjson_pool_value &, const convert_options &);
+template feature convert<feature>(const rapidjson_pool_value &, const convert_options &);
+template feature_collection convert<feature_collection>(const rapidjson_pool_value &, const convert_options &);
+
+// Specialized implementation for geojson.
+geojson convert(const rapidjson_pool_value &json, const convert_options &options) {
+    return convert<geojson>(json, options);
+}
+
+#if defined(GEOJSON_SIMDJSON)
+// Instantiate the template.
+template geojson parse_simdjson<geojson>(std::string_view, transform_ref<double>);
+template geometry parse_simdjson<geometry>(std::string_view, transform_ref<double>);
+template feature parse_simdjson<feature>(std::string_view, transform_ref<double>);
+template feature_collection parse_simdjson<feature_collection>(std::string_view, transform_ref<double>);
+template geojson parse_simdjson<geojson>(std::string_view, const parse_options &, transform_ref<double>);
+template geometry parse_simdjson<geometry>(std::string_view, const parse_options &, transform_ref<double>);
+template feature parse_simdjson<feature>(std::string_view, const parse_options &, transform_ref<double>);
+template feature_collection
+parse_simdjson<feature_collection>(std::string_view, const parse_options &, transform_ref<double>);
+
+// Specialized implementation for geojson.
+geojson parse_simdjson(std::string_view json) {
+    return parse_simdjson<geojson>(json);
+}
+
+geojson parse_simdjson(std::string_view json, const parse_options &options) {
+    return parse_simdjson<geojson>(json, options);
+}
+#endif
+
+// rapidjson::InsituStringStream reading at most length bytes instead of up to a NUL terminator.
+class insitu_stream {
+public:
+    using Ch = char;
+
+    insitu_stream(char *json, std::size_t length) : src(json), dst(nullptr), head(json), tail(json + length) {
+    }
+
+    Ch Peek() const {
+        return src == tail ? '\0' : *src;
+    }
+
+    Ch Take() {
+        return src == tail ? '\0' : *src++;
+    }
+
+    std::size_t Tell() const {
+        return static_cast<std::size_t>(src - head);
+    }
+
+    Ch *PutBegin() {
+        return dst = head + (src - head);
+    }
+
+    void Put(Ch c) {
+        *dst++ = c;
+    }
+
+    std::size_t PutEnd(Ch *begin) {
+        return static_cast<std::size_t>(dst - begin);
+    }
+
+    void Flush() {
+    }
+
+    // The unread input, for reader_handler::scanFrom().
+    const char **cursor() {
+        return &src;
+    }
+
+    const char *end() const {
+        return tail;
+    }
+
+private:
+    const char *src;
+    char *dst;
+    char *head;
+    const char *tail;
+};
+
+template <class T>
+T parse_insitu(char *json, std::size_t length) {
+    reader_handler<T> handler;
+    insitu_stream stream(json, length);
+    handler.scanFrom(stream.cursor(), stream.end());
+    return read<rapidjson::kParseInsituFlag>(stream, handler);
+}
+
+// Instantiate the template.
+template geojson parse_insitu<geojson>(char *, std::size_t);
+template geometry parse_insitu<geometry>(char *, std::size_t);
+template feature parse_insitu<feature>(char *, std::size_t);
+template feature_collection parse_insitu<feature_collection>(char *, std::size_t);
+
+// Specialized implementation for geojson.
+geojson parse_insitu(char *json, std::size_t length) {
+    return parse_insitu<geojson>(json, length);
+}
+
+template <class T>
+T pmr::parse(std::string_view json, std::pmr::memory_resource *resource) {
+    reader_handler<T> handler(resource);
+    return read(json.data(), json.size(), handler);
+}
+
+// Instantiate the template.
+template pmr::geojson pmr::parse<pmr::geojson>(std::string_view, std::pmr::memory_resource *);
+template pmr::geometry pmr::parse<pmr::geometry>(std::string_view, std::pmr::memory_resource *);
+template pmr::feature pmr::parse<pmr::feature>(std::string_view, std::pmr::memory_resource *);
+template pmr::feature_collection pmr::parse<pmr::feature_collection>(std::string_view, std::pmr::memory_resource *);
+
+// Specialized implementation for geojson.
+pmr::geojson pmr::parse(std::string_view json, std::pmr::memory_resource *resource) {
+    return pmr::parse<pmr::geojson>(json, resource);
+}
+
+void requireFeatureCollection(const geojson &result) {
+    if (!std::holds_alternative<feature_collection>(result))
+        throw error("GeoJSON must be a FeatureCollection");
+}
+
+template <class Stream>
+void readFeatures(Stream &stream, const feature_callback &callback) {
+    reader_handler<geojson> handler(callback);
+    requireFeatureCollection(read(stream, handler));
+}
+
+void for_each_feature(std::string_view json, const feature_callback &callback) {
+    reader_handler<geojson> handler(callback);
+    requireFeatureCollection(read(json.data(), json.size(), handler));
+}
+
+void for_each_feature(std::istream &input, const feature_callback &callback) {
+    rapidjson::IStreamWrapper stream(input);
+    readFeatures(stream, callback);
+}
+
+void for_each_feature(std::FILE *file, const feature_callback &callback) {
+    // On the heap, since readers may run on threads with small stacks.
+    constexpr std::size_t size = 65536;
+    const auto buffer          = std::make_unique_for_overwrite<char[]>(size);
+    rapidjson::FileReadStream stream(file, buffer.get(), size);
+    readFeatures(stream, callback);
+}
+
+} // namespace geojson
+} // namespace maplibre
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/seq.hpp>
+#include <maplibre/geojson_file_impl.hpp>
+#include <maplibre/geojson_impl.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <future>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace maplibre {
+namespace geojson {
+
+constexpr char recordSeparator = '\x1e';
+
+// A sequence split into chunks of records. Chunk i spans the records starting between i * chunk_size
+// and (i + 1) * chunk_size, so chunks can be located without scanning the input before them.
+class seq_input {
+public:
+    seq_input(std::string_view input, const seq_options &options)
+        : data(input),
+          chunkSize(std::max<std::size_t>(options.chunk_size, 1)),
+          separator(firstNonSpace() < data.size() && data[firstNonSpace()] == recordSeparator ? recordSeparator
+                                                                                              : '\n') {
+    }
+
+    std::size_t chunks() const {
+        return (data.size() + chunkSize - 1) / chunkSize;
+    }
+
+    // The offset the chunk's records start at.
+    std::size_t chunkBegin(std::size_t chunk) const {
+        return boundary(chunk * chunkSize);
+    }
+
+    // Calls visit(record, offset) for the non-blank records of the chunk, in order.
+    template <class Visit>
+    void forEachRecord(std::size_t chunk, const Visit &visit) const {
+        const std::size_t end = boundary((chunk + 1) * chunkSize);
+        for (std::size_t begin = chunkBegin(chunk); begin < end;) {
+            std::size_t next = data.find(separator, separator == recordSeparator ? begin + 1 : begin);
+            next             = next == std::string_view::npos ? data.size() : next;
+
+            std::size_t first = begin;
+            std::size_t last  = next;
+            if (first < last && data[first] == recordSeparator)
+                ++first;
+            while (first < last && isSpace(data[first]))
+                ++first;
+            while (last > first && isSpace(data[last - 1]))
+                --last;
+            if (first < last)
+                visit(data.substr(first, last - first), first);
+
+            begin = separator == recordSeparator ? next : next + 1;
+        }
+    }
+
+private:
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    std::size_t firstNonSpace() const {
+        std::size_t i = 0;
+        while (i < data.size() && isSpace(data[i]))
+            ++i;
+        return i;
+    }
+
+    // The first record start at or after the offset: records start at the beginning, after line feeds in
+    // newline-delimited input, and at record separators otherwise.
+    std::size_t boundary(std::size_t offset) const {
+        if (offset == 0 || offset >= data.size())
+            return std::min(offset, data.size());
+        if (separator == recordSeparator) {
+            const std::size_t next = data.find(recordSeparator, offset);
+            return next == std::string_view::npos ? data.size() : next;
+        }
+        const std::size_t next = data.find('\n', offset - 1);
+        return next == std::string_view::npos ? data.size() : next + 1;
+    }
+
+    std::string_view data;
+    std::size_t chunkSize;
+    char separator;
+};
+
+feature parseRecord(std::string_view record, std::size_t offset) {
+    try {
+        return parse<feature>(record);
+    } catch (const error &err) {
+        throw error("record at byte " + std::to_string(offset) + ": " + err.what());
+    }
+}
+
+// The features of a chunk, up to its first invalid record.
+struct seq_chunk {
+    std::vector<feature> features;
+    std::exception_ptr failure;
+};
+
+seq_chunk parseChunk(const seq_input &input, std::size_t chunk) {
+    seq_chunk result;
+    try {
+        input.forEachRecord(chunk, [&](std::string_view record, std::size_t offset) {
+            result.features.push_back(parseRecord(record, offset));
+        });
+    } catch (...) {
+        result.failure = std::current_exception();
+    }
+    return result;
+}
+
+struct seq_reader::impl {
+    impl(std::unique_ptr<mapped_file> mapped, std::string_view data, const seq_options &options)
+        : file(std::move(mapped)), input(data, options), window(resolveThreads(options.threads)) {
+    }
+
+    bool next(feature &result) {
+        while (position == current.features.size()) {
+            if (current.failure) {
+                const auto failure = current.failure;
+                current.failure    = nullptr;
+                finished           = true;
+                std::rethrow_exception(failure);
+            }
+            if (finished)
+                return false;
+
+            // Keeps up to window chunks parsing ahead of the one being read.
+            while (pending.size() < window && launched < input.chunks()) {
+                pending.push_back(
+                    std::async(std::launch::async, [this, chunk = launched] { return parseChunk(input, chunk); }));
+                ++launched;
+            }
+            if (pending.empty()) {
+                finished = true;
+                return false;
+            }
+
+            current  = pending.front().get();
+            position = 0;
+            pending.pop_front();
+        }
+
+        result = std::move(current.features[position++]);
+        return true;
+    }
+
+    std::unique_ptr<mapped_file> file;
+    seq_input input;
+    std::size_t window;
+    std::size_t launched = 0;
+    seq_chunk current;
+    std::size_t position = 0;
+    bool finished        = false;
+    // Last, so that running parses are waited for before the input they read is destroyed.
+    std::deque<std::future<seq_chunk>> pending;
+};
+
+seq_reader::seq_reader(std::string_view data, const seq_options &options)
+    : state(std::make_unique<impl>(nullptr, data, options)) {
+}
+
+seq_reader::seq_reader(std::unique_ptr<impl> reader) : state(std::move(reader)) {
+}
+
+seq_reader seq_reader::open(const std::filesystem::path &path, const seq_options &options) {
+    auto file = std::make_unique<mapped_file>(path);
+    file->adviseSequential();
+    const auto data = file->data();
+    return seq_reader(std::make_unique<impl>(std::move(file), data, options));
+}
+
+seq_reader::seq_reader(seq_reader &&) noexcept            = default;
+seq_reader &seq_reader::operator=(seq_reader &&) noexcept = default;
+seq_reader::~seq_reader()                                 = default;
+
+bool seq_reader::next(feature &result) {
+    return state->next(result);
+}
+
+void forEachSeqFeature(const seq_input &input, const feature_callback &callback, const seq_options &options) {
+    const std::size_t chunks = input.chunks();
+    const auto threads       = static_cast<unsigned>(std::min<std::size_t>(resolveThreads(options.threads), chunks));
+
+    std::atomic<std::size_t> next{ 0 };
+    first_failure failure;
+
+    runThreads(std::max(threads, 1u), [&] {
+        for (std::size_t chunk; (chunk = next++) < chunks && !failure.recordedBefore(input.chunkBegin(chunk));) {
+            std::size_t position = input.chunkBegin(chunk);
+            try {
+                input.forEachRecord(chunk, [&](std::string_view record, std::size_t offset) {
+                    position = offset;
+                    callback(parseRecord(record, offset));
+                });
+            } catch (...) {
+                failure.record(position);
+            }
+        }
+    });
+
+    failure.rethrow();
+}
+
+void for_each_seq_file_feature(const std::filesystem::path &path,
+                               const feature_callback &callback,
+                               const seq_options &options) {
+    const mapped_file file(path);
+    forEachSeqFeature(seq_input(file.data(), options), callback, options);
+}
+
+void for_each_seq_feature(std::string_view data, const feature_callback &callback, const seq_options &options) {
+    forEachSeqFeature(seq_input(data, options), callback, options);
+}
+
+seq_writer::seq_writer(std::ostream &stream, seq_format sequenceFormat, const stringify_options &stringifyOptions)
+    : output(stream), format(sequenceFormat), options(stringifyOptions) {
+}
+
+void seq_writer::write(const feature &element) {
+    if (format == seq_format::rfc8142)
+        output.put(recordSeparator);
+    maplibre::geojson::write(element, output, options);
+    output.put('\n');
+}
+
+void seq_writer::write(const feature_collection &collection) {
+    for (const auto &element : collection) {
+        write(element);
+    }
+}
+
+} // namespace geojson
+} // namespace maplibre
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <maplibre/geojson.hpp>
+#include <maplibre/geojson/pool_allocator.hpp>
+#include <maplibre/geojson/stats.hpp>
+#include <maplibre/geojson_impl.hpp>
+#include <maplibre/geojson_reader_impl.hpp>
+
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+namespace maplibre {
+namespace geojson {
+
+// rapidjson allocator counting the blocks it takes from the C heap, like rapidjson::CrtAllocator does, for
+// the stacks and buffers of the readers and writers timed below. Every reallocation counts as a new block.
+class counting_allocator {
+public:
+    static const bool kNeedFree = true;
+
+    void *Malloc(std::size_t size) {
+        if (!size)
+            return nullptr;
+        count(size);
+        return std::malloc(size);
+    }
+
+    void *Realloc(void *original, std::size_t, std::size_t newSize) {
+        if (!newSize) {
+            std::free(original);
+            return nullptr;
+        }
+        count(newSize);
+        return std::realloc(original, newSize);
+    }
+
+    static void Free(void *block) {
+        std::free(block);
+    }
+
+    std::size_t allocations = 0;
+    std::size_t bytes       = 0;
+    std::size_t largest     = 0;
+
+private:
+    void count(std::size_t size) {
+        ++allocations;
+        bytes += size;
+        largest = std::max(largest, size);
+    }
+};
+
+using counted_pool_document = rapidjson::GenericDocument<rapidjson::UTF8<>, pool_allocator, counting_allocator>;
+
+template <class T>
+parse_with_stats_result<T> parse_with_stats(std::string_view json, const parse_options &options) {
+    using clock = std::chrono::steady_clock;
+
+    parse_stats stats;
+    stats.input_bytes = json.size();
+
+    const auto start = clock::now();
+    pool_allocator pool;
+    counting_allocator stack;
+    counted_pool_document document(&pool, 1024, &stack);
+    document.Parse(json.data(), json.size());
+    if (document.HasParseError()) {
+        std::stringstream message;
+        message << document.GetErrorOffset() << " - " << rapidjson::GetParseError_En(document.GetParseError());
+        throw error(message.str());
+    }
+    const auto tokenized = clock::now();
+
+    reader_handler<T, validation_clock> handler;
+    handler.applyOptions(options);
+    handler.timeValidation(validation_clock(stats.validate));
+    document.Accept(handler);
+    T result             = handler.result();
+    const auto converted = clock::now();
+
+    stats.tokenize        = tokenized - start;
+    stats.convert         = converted - tokenized;
+    stats.elapsed         = converted - start;
+    stats.document_bytes  = pool.Size();
+    stats.allocations     = pool.ChunkCount() + stack.allocations;
+    stats.bytes_allocated = pool.Capacity() + stack.bytes;
+    // The document is held whole until converted, and the stack is freed only after tokenizing.
+    stats.peak_bytes = pool.Capacity() + stack.largest;
+    return { std::move(result), stats };
+}
+
+// Instantiate the template.
+template parse_with_stats_result<geojson> parse_with_stats<geojson>(std::string_view, const parse_options &);
+template parse_with_stats_result<geometry> parse_with_stats<geometry>(std::string_view, const parse_options &);
+template parse_with_stats_result<feature> parse_with_stats<feature>(std::string_view, const parse_options &);
+template parse_with_stats_result<feature_collection> parse_with_stats<feature_collection>(std::string_view,
+                                                                                          const parse_options &);
+
+// Specialized implementation for geojson.
+parse_with_stats_result<geojson> parse_with_stats(std::string_view json, const parse_options &options) {
+    return parse_with_stats<geojson>(json, options);
+}
+
+template <class T>
+parse_with_stats_result<T> pmr::parse_with_stats(std::string_view json, counting_resource &resource) {
+    using clock = std::chrono::steady_clock;
+
+    parse_stats stats;
+    stats.input_bytes                = json.size();
+    const std::size_t allocations    = resource.allocations();
+    const std::size_t bytesAllocated = resource.bytes_allocated();
+    const std::size_t bytesInUse     = resource.bytes_in_use();
+    resource.reset_peak();
+
+    const auto start = clock::now();
+    reader_handler<T, validation_clock> handler(&resource);
+    handler.timeValidation(validation_clock(stats.validate));
+    T result      = read(json.data(), json.size(), handler);
+    stats.elapsed = clock::now() - start;
+
+    stats.allocations     = resource.allocations() - allocations;
+    stats.bytes_allocated = resource.bytes_allocated() - bytesAllocated;
+    stats.peak_bytes      = resource.peak_bytes() - bytesInUse;
+    // Moved rather than assigned into the result, which would copy it out of the resource.
+    return { std::move(result), stats };
+}
+
+// Instantiate the template.
+template parse_with_stats_result<pmr::geojson> pmr::parse_with_stats<pmr::geojson>(std::string_view,
+                                                                                  counting_resource &);
+template parse_with_stats_result<pmr::geometry> pmr::parse_with_stats<pmr::geometry>(std::string_view,
+                                                                                    counting_resource &);
+template parse_with_stats_result<pmr::feature> pmr::parse_with_stats<pmr::feature>(std::string_view,
+                                                                                  counting_resource &);
+template parse_with_stats_result<pmr::feature_collection>
+pmr::parse_with_stats<pmr::feature_collection>(std::string_view, counting_resource &);
+
+// Specialized implementation for geojson.
+parse_with_stats_result<pmr::geojson> pmr::parse_with_stats(std::string_view json, counting_resource &resource) {
+    return parse_with_stats<pmr::geojson>(json, resource);
+}
+
+template <class T>
+stringify_with_stats_result stringify_with_stats(const T &element, const stringify_options &options) {
+    using clock = std::chrono::steady_clock;
+
+    stringify_with_stats_result result;
+    stringify_stats &stats = result.stats;
+
+    const auto start = clock::now();
+    counting_allocator allocator;
+    {
+        rapidjson::GenericStringBuffer<rapidjson::UTF8<>, counting_allocator> buffer(&allocator);
+        rapidjson::Writer<decltype(buffer), rapidjson::UTF8<>, rapidjson::UTF8<>, counting_allocator> writer(
+            buffer, &allocator);
+        serialize(element, writer, options);
+        result.result = buffer.GetString();
+    }
+    stats.elapsed = clock::now() - start;
+
+    stats.allocations     = allocator.allocations;
+    stats.bytes_allocated = allocator.bytes;
+    // The returned string allocates unless its short string buffer holds the output.
+    if (result.result.capacity() > std::string().capacity()) {
+        ++stats.allocations;
+        stats.bytes_allocated += result.result.capacity() + 1;
+    }
+    stats.output_bytes = result.result.size();
+    return result;
+}
+
+// Instantiate the template.
+template stringify_with_stats_result stringify_with_stats<geojson>(const geojson &, const stringify_options &);
+template stringify_with_stats_result stringify_with_stats<geometry>(const geometry &, const stringify_options &);
+template stringify_with_stats_result stringify_with_stats<feature>(const feature &, const stringify_options &);
+template stringify_with_stats_result stringify_with_stats<feature_collection>(const feature_collection &,
+                                                                              const stringify_options &);
+
+} // namespace geojson
+} // namespace maplibre
@@ -121,8 +121,22 @@ geometry convert<geometry>(const value &val) {
     throw error(typeString + " not yet implemented");
 }
 
-template <>
-feature convert<feature>(const value &val) {
+// The properties the filter keeps, without copying the others.
+value::object_type filterProperties(const value::object_type &properties, const property_filter &filter) {
+    if (filter.mode == property_mode::all)
+        return properties;
+
+    value::object_type result;
+    if (filter.mode == property_mode::none)
+        return result;
+    for (const auto &property : properties) {
+        if (filter.keeps(property.first))
+            result.emplace(property);
+    }
+    return result;
+}
+
+feature convertFeature(const value &val, const parse_options &options) {
     auto valueObject = val.getObject();
     if (!valueObject) {
         throw error("GeoJSON must be an object");
@@ -147,7 +161,7 @@ feature convert<feature>(const value &val) {
         throw error("Feature must have a geometry property");
     }
 
-    feature result{ convert<geometry>(geometryIt->second) };
+    feature result{ options.geometries ? convert<geometry>(geometryIt->second) : geometry{ empty{} } };
     auto idIt = valueObject->find("id");
     if (idIt != valueObject->end()) {
         result.id = std::visit(
@@ -165,14 +179,24 @@ feature convert<feature>(const value &val) {
         if (!std::holds_alternative<value::object_ptr_type>(propertiesIt->second)) {
             throw error("properties must be an object");
         }
-        result.properties = *propertiesIt->second.getObject();
+        result.properties = filterProperties(*propertiesIt->second.getObject(), options.properties);
     }
 
     return result;
 }
 
 template <>
-geojson convert<geojson>(const value &val) {
+feature convert<feature>(const value &val) {
+    return convertFeature(val, parse_options{});
+}
+
+template <typename T>
+T convert(const value &val, const parse_options &) {
+    return convert<T>(val);
+}
+
+template <>
+geojson convert<geojson>(const value &val, const parse_options &options) {
     auto valueObject = val.getObject();
     if (!valueObject) {
         throw error("GeoJSON must be an object");
@@ -203,19 +227,46 @@ geojson convert<geojson>(const value &val) {
         feature_collection collection;
         collection.reserve(featureArray->size());
         for (const auto &featureValue : *featureArray) {
-            collection.push_back(convert<feature>(featureValue));
+            collection.push_back(convertFeature(featureValue, options));
         }
         return geojson{ collection };
     }
 
     if (typeString == "Feature") {
-        return geojson{ convert<feature>(val) };
+        return geojson{ convertFeature(val, options) };
     }
 
     return geojson{ convert<geometry>(val) };
 }
 
+template <>
+geojson convert<geojson>(const value &val) {
+    return convert<geojson>(val, parse_options{});
+}
+
+template <>
+feature convert<feature>(const value &val, const parse_options &options) {
+    return convertFeature(val, options);
+}
+
+template <>
+feature_collection convert<feature_collection>(const value &val, const parse_options &options) {
+    assert(std::holds_alternative<std::shared_ptr<std::vector<value>>>(val));
+    if (!std::holds_alternative<std::shared_ptr<std::vector<value>>>(val)) {
+        throw error("coordinates must be of an Array type");
+    }
+
+    const auto &featureArray = *val.getArray();
+    feature_collection collection;
+    collection.reserve(featureArray.size());
+    for (const auto &featureValue : featureArray) {
+        collection.push_back(convertFeature(featureValue, options));
+    }
+    return collection;
+}
+
 template feature_collection convert<feature_collection>(const value &);
+template geometry convert<geometry>(const value &, const parse_options &);
 
 geojson convert(const value &val) {
     return std::visit(
@@ -229,6 +280,20 @@ geojson convert(const value &val) {
         val);
 }
 
+geojson convert(const value &val, const parse_options &options) {
+    return std::visit(
+        overloaded{ [](const null_value_t &) -> geojson { return geometry{}; },
+                    [&](const std::string &jsonString) {
+                        return jsonString == "null" ? geometry{} : parse(jsonString, options);
+                    },
+                    [&](const value::object_type &jsonObject) {
+                        return convert<geojson>(static_cast<const maplibre::geojson::value &>(jsonObject), options);
+                    },
+                    [&](const value::object_ptr_type obj) { return convert<geojson>(*obj, options); },
+                    [](const auto &) -> geojson { throw error("Invalid GeoJSON value was provided."); } },
+        val);
+}
+
 value convert(const point &p) {
     return value::array_type{ p.x, p.y };
 }
@@ -1,2 +1,12 @@
+#include <maplibre/geojson_bbox_impl.hpp>
+#include <maplibre/geojson_columnar_impl.hpp>
+#include <maplibre/geojson_file_impl.hpp>
+#include <maplibre/geojson_flat_impl.hpp>
 #include <maplibre/geojson_impl.hpp>
+#include <maplibre/geojson_index_impl.hpp>
+#include <maplibre/geojson_interned_impl.hpp>
+#include <maplibre/geojson_lazy_impl.hpp>
+#include <maplibre/geojson_reader_impl.hpp>
+#include <maplibre/geojson_seq_impl.hpp>
+#include <maplibre/geojson_stats_impl.hpp>
 #include <maplibre/geojson_value_impl.hpp>
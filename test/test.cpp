@@ -1,14 +1,38 @@
 #include <maplibre/geojson.hpp>
+#include <maplibre/geojson/bbox.hpp>
+#include <maplibre/geojson/columnar.hpp>
+#include <maplibre/geojson/flat.hpp>
+#include <maplibre/geojson/index.hpp>
+#include <maplibre/geojson/interned.hpp>
+#include <maplibre/geojson/lazy.hpp>
+#include <maplibre/geojson/pmr.hpp>
 #include <maplibre/geojson/rapidjson.hpp>
+#include <maplibre/geojson/seq.hpp>
+#include <maplibre/geojson/stats.hpp>
 #include <maplibre/geometry.hpp>
 
+#include <rapidjson/error/en.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <memory_resource>
+#include <mutex>
+#include <random>
 #include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
 
 using namespace maplibre::geojson;
 
@@ -291,6 +315,1244 @@ static void testParseErrorHandling() {
     }
 }
 
+static void testReaderMatchesDocument() {
+    const std::vector<std::string> inputs = {
+        R"({"coordinates": [1, 2], "type": "Point"})",
+        R"({"type": "Point", "coordinates": [1, 2, 3], "type": "LineString", "coordinates": []})",
+        R"({"type": "Point", "features": 5, "geometry": [], "coordinates": [0, 0]})",
+        R"({"type": "Point", "coordinates": {"x": 1}})",
+        R"({"type": "Point", "coordinates": [1, "2"]})",
+        R"({"type": "Circle", "coordinates": []})",
+        R"({"type": 5, "coordinates": []})",
+        R"({"type": "Polygon", "coordinates": [[[0, 0], [1, 0], [1, 1], [0, 0]]], "bbox": [0, 0, 1, 1]})",
+        R"({"type": "MultiLineString", "coordinates": [[[0, 0], [1, 1]], [[2, 2]]]})",
+        R"({"type": "GeometryCollection", "geometries": [null, {"type": "Point", "coordinates": [1, 2]}]})",
+        R"({"type": "GeometryCollection", "geometries": {}})",
+        R"({"type": "Feature", "properties": [], "geometry": {"type": "Point"}})",
+        R"({"type": "Feature", "geometry": null, "id": {}})",
+        R"({"type": "Feature", "geometry": null, "properties": null, "id": 1.5})",
+        R"({"type": "Feature", "geometry": null, "id": -5, "properties": {"a": 1, "a": 2, "b": [{"c": null}]}})",
+        R"({"features": [], "type": "FeatureCollection"})",
+        R"({"type": "FeatureCollection", "features": [{"type": "Feature", "geometry": null}, 5, {"type": "X"}]})",
+        R"({"type": "Feature", "geometry": 5,})",
+        R"({"type": "LineString", "coordinates": [ [ -0 , 0.5 ] ,[1e2, -12345.678901234567] ]})",
+        R"({"type": "Point", "coordinates": [1, 2,]})",
+        R"({"type": "Point", "coordinates": [01, 2]})",
+        R"({"type": "Point", "coordinates": [1., 2]})",
+        R"({"type": "MultiPoint", "coordinates": [[1, 2], null, [3, 4]]})",
+        R"({"type": "MultiPoint", "coordinates": [[1, 2] [3, 4]]})",
+        R"({"type": "Point", "coordinates": [1, 2)",
+        R"({"features": []})",
+        R"({"type": "Feature", "geometry": null, "id": 18446744073709551616,)"
+        R"( "properties": {"a": -9223372036854775809, "b": 9223372036854775808}})",
+        R"({"type": "Feature", "geometry": null, "properties": {"a": 1e400}})",
+        R"({"type": "Feature", "geometry": null, "properties": {"a": "\u00e9\ud83d\ude00", "\u0062": "\n\t"}})",
+        "{\"type\": \"Feature\", \"geometry\": null, \"properties\": {\"a\": \"\xff\xfe\"}}",
+        "{\"type\": \"Feature\", \"geometry\": null, \"properties\": {\"a\": \"\t\"}}",
+        R"({"type": "Feature", "geometry": null, "properties": {"a": [)" + std::string(2000, '[') +
+            std::string(2001, ']') + "}}",
+        R"({"type": "Point", "coordinates": [1, 2]} {})",
+        R"({"type": "Point", "coordinates": [1, 2]})" "\n \t",
+        R"("Point")",
+        R"([1, 2])",
+        R"(null)",
+        "",
+    };
+
+    for (const auto &json : inputs) {
+        geojson documentResult;
+        geojson readerResult;
+        std::string documentError;
+        std::string readerError;
+
+        try {
+            rapidjson_document d;
+            d.Parse<0>(json.c_str());
+            if (d.HasParseError()) {
+                std::stringstream message;
+                message << d.GetErrorOffset() << " - " << rapidjson::GetParseError_En(d.GetParseError());
+                throw std::runtime_error(message.str());
+            }
+            documentResult = convert<geojson>(d);
+        } catch (const std::runtime_error &err) {
+            documentError = err.what();
+        }
+
+        try {
+            readerResult = parse(json);
+        } catch (const std::runtime_error &err) {
+            readerError = err.what();
+        }
+
+        assert(documentError == readerError);
+        assert(documentResult == readerResult);
+    }
+}
+
+// Coordinates read by the reader's own number scanning have to be bit-identical to the ones rapidjson
+// produces, including where rapidjson's default parsing isn't correctly rounded.
+static void testReaderNumbersMatchDocument() {
+    std::uint64_t state = 88172645463325252u;
+    const auto next     = [&] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    std::string json = R"({"type": "LineString", "coordinates": [)";
+    for (int i = 0; i < 20000; ++i) {
+        double number;
+        const std::uint64_t bits = next();
+        std::memcpy(&number, &bits, sizeof(number));
+        std::string text;
+        switch (i % 5) {
+        case 0: // any double, with exponents
+            text = (std::stringstream() << std::setprecision(17) << number).str();
+            break;
+        case 1: // longitude-like, up to 17 digits
+            text = (std::stringstream() << std::setprecision(1 + int(bits % 17)) << std::fixed
+                                        << (double(bits % 360000000000) / 1e9 - 180))
+                       .str();
+            break;
+        case 2: // integers
+            text = std::to_string(std::int64_t(bits) >> (bits % 64));
+            break;
+        case 3: // many decimals, past the 53-bit significand
+            text = "0." + std::to_string(bits) + std::to_string(bits % 1000);
+            break;
+        default:
+            text = (i % 2 ? "-" : "") + std::to_string(bits % 1000) + "." + std::string(bits % 25, '0') + "1";
+        }
+        if (text.find_first_of("ni") != std::string::npos)
+            text = "0";
+        json += (i ? ", [" : "[") + text + ", -0.0]";
+    }
+    json += "]}";
+
+    rapidjson_document d;
+    d.Parse<0>(json.c_str());
+    assert(!d.HasParseError());
+    const auto expected = std::get<line_string>(convert<geometry>(d));
+    const auto actual   = std::get<line_string>(parse<geometry>(json));
+
+    assert(actual.size() == expected.size());
+    assert(std::memcmp(actual.data(), expected.data(), actual.size() * sizeof(point)) == 0);
+}
+
+static void testStringifyMatchesDocument() {
+    for (const auto *path : { "test/fixtures/point.json", "test/fixtures/multi-polygon.json",
+                              "test/fixtures/geometry-collection.json", "test/fixtures/feature.json",
+                              "test/fixtures/feature-null-geometry.json", "test/fixtures/feature-id.json" }) {
+        const auto data = readGeoJSON(path, false);
+        assert(writeGeoJSON(data, false) == writeGeoJSON(data, true));
+    }
+}
+
+static void testStringifyPrecision() {
+    const geometry location{ point{ -122.41941557, 37.77492951 } };
+    assert(stringify(location, { 6 }) == R"({"type":"Point","coordinates":[-122.419416,37.77493]})");
+    assert(stringify(location, { -1 }) == stringify(location));
+
+    const geometry points{ multi_point{ { -0.0000001, 30 }, { 2.5, 1e300 } } };
+    assert(stringify(points, { 0 }) == R"({"type":"MultiPoint","coordinates":[[0.0,30.0],[3.0,1e300]]})");
+
+    std::ostringstream output;
+    write(location, output, { 6 });
+    assert(output.str() == stringify(location, { 6 }));
+}
+
+static void testWrite() {
+    const auto data     = readGeoJSON("test/fixtures/feature-collection.json", false);
+    const auto expected = stringify(data);
+
+    std::ostringstream output;
+    write(data, output);
+    assert(output.str() == expected);
+
+    std::string chunks;
+    write(data, [&](const char *chunk, std::size_t size) { chunks.append(chunk, size); });
+    assert(chunks == expected);
+
+    // Long outputs arrive in several chunks of at most 64 KiB.
+    line_string points;
+    points.resize(20000, point(123.456, -78.9));
+    const geometry line{ points };
+    std::size_t calls = 0;
+    chunks.clear();
+    write(line, [&](const char *chunk, std::size_t size) {
+        assert(size <= 65536);
+        chunks.append(chunk, size);
+        ++calls;
+    });
+    assert(calls > 1 && chunks == stringify(line));
+
+    std::FILE *file = std::tmpfile();
+    assert(file);
+    write(data, file);
+    std::rewind(file);
+    std::string contents(expected.size(), '\0');
+    assert(std::fread(contents.data(), 1, contents.size(), file) == contents.size());
+    std::fclose(file);
+    assert(contents == expected);
+}
+
+static void testParseBuffer() {
+    const std::string json  = R"({"type": "Point", "coordinates": [30.5, 50.5]})";
+    const std::string input = json + "trailing bytes that are not part of the input";
+
+    assert(parse(std::string_view(input.data(), json.size())) == parse(json));
+    assert((parse<geometry>(input.data(), json.size()) == geometry{ point{ 30.5, 50.5 } }));
+
+    try {
+        parse(std::string_view(input.data(), json.size() - 1));
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(std::string(err.what()).find("Missing a comma or '}'") != std::string::npos);
+    }
+
+    // Padded input reads like any other, whatever the padding holds, and so does input with too little.
+    const std::string padded = input + std::string(parse_padding, '9');
+    assert(parse_padded(std::string_view(padded.data(), json.size()), padded.size()) == parse(json));
+    assert(parse_padded(std::string_view(padded.data(), json.size()), json.size()) == parse(json));
+    try {
+        parse_padded<geometry>(std::string_view(padded.data(), json.size() - 1), padded.size());
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(std::string(err.what()).find("Missing a comma or '}'") != std::string::npos);
+    }
+
+    // A byte order mark is skipped, and counted in error offsets as by the length-aware Document::Parse().
+    const std::string bom = "\xEF\xBB\xBF";
+    assert(parse_rapidjson(bom + json) == parse(json));
+    const std::string invalid = bom + R"({"type": "Point", "coordinates": [30.5,)";
+    rapidjson_document d;
+    d.Parse(invalid.data(), invalid.size());
+    try {
+        parse_rapidjson(invalid);
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(std::string(err.what()).rfind(std::to_string(d.GetErrorOffset()) + " - ", 0) == 0);
+    }
+}
+
+// parse() reads in-memory input with simdjson when built with GEOJSON_SIMDJSON, and has to produce what
+// rapidjson does, errors included.
+static void testParseBackends() {
+    for (const auto &entry : std::filesystem::directory_iterator("test/fixtures")) {
+        std::ifstream input(entry.path());
+        std::stringstream buffer;
+        buffer << input.rdbuf();
+        const std::string json = buffer.str();
+
+        for (const bool truncate : { false, true }) {
+            const std::string_view text(json.data(), truncate ? json.size() / 2 : json.size());
+            geojson expected;
+            geojson actual;
+            std::string expectedError;
+            std::string actualError;
+
+            try {
+                expected = parse_rapidjson(text);
+            } catch (const std::runtime_error &err) {
+                expectedError = err.what();
+            }
+
+            try {
+                actual = parse(text);
+            } catch (const std::runtime_error &err) {
+                actualError = err.what();
+            }
+
+            assert(expectedError == actualError);
+            assert(expected == actual);
+        }
+    }
+}
+
+static void testPropertyFilter() {
+    const std::string json = R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "geometry": null, "properties": {"a": 1, "b": {"a": [1, {"c": 2}]}, "c": "x"}},
+        {"type": "Feature", "geometry": null, "properties": null},
+        {"type": "Feature", "geometry": null, "properties": {"b": [], "d": true}}]})";
+
+    rapidjson_document document;
+    document.Parse(json.c_str());
+    const auto full = std::get<feature_collection>(parse(json));
+
+    const std::vector<property_filter> filters = {
+        { property_mode::all, {} },
+        { property_mode::allow, { "a", "b" } },
+        { property_mode::deny, { "b" } },
+        { property_mode::none, { "a" } },
+    };
+    for (const auto &filter : filters) {
+        feature_collection expected = full;
+        for (auto &element : expected) {
+            for (auto it = element.properties.begin(); it != element.properties.end();) {
+                it = filter.keeps(it->first) ? std::next(it) : element.properties.erase(it);
+            }
+        }
+
+        const parse_options options{ filter };
+        assert(parse(json, options) == geojson{ expected });
+        assert(parse_rapidjson(json, options) == geojson{ expected });
+        const auto single = parse<feature>(R"({"type": "Feature", "geometry": null, "properties": {"b": 2}})", options);
+        assert(single.properties.count("b") == (filter.keeps("b") ? 1u : 0u));
+        assert(convert(document, convert_options{ 1, filter }) == geojson{ expected });
+        assert(convert<feature_collection>(document["features"], convert_options{ 2, filter }) == expected);
+    }
+
+    // Skipped values are still validated, and a dropped properties member must still be an object.
+    const parse_options drop{ { property_mode::none, {} } };
+    for (const auto *invalid : {
+             R"({"type": "Feature", "geometry": null, "properties": 1})",
+             R"({"type": "Feature", "geometry": null, "properties": {"a": [1, 2}})",
+         }) {
+        std::string expected;
+        std::string actual;
+        try {
+            parse(invalid);
+        } catch (const std::runtime_error &err) {
+            expected = err.what();
+        }
+        try {
+            parse(invalid, drop);
+        } catch (const std::runtime_error &err) {
+            actual = err.what();
+        }
+        assert(!expected.empty() && expected == actual);
+    }
+}
+
+static void testParseModes() {
+    const std::string features = R"(
+        {"type": "Feature", "id": 1, "geometry": {"type": "Point", "coordinates": [1.5, -2]}, "properties": {"a": 1}},
+        {"type": "Feature", "geometry": {"type": "LineString", "coordinates": [[0, 0], [1e2, 1E-2], [0.1, -0]]},
+         "properties": {"b": [[1, 2], [3]]}})";
+    const std::string valid = R"({"type": "FeatureCollection", "features": [)" + features + "]}";
+    // Skipped geometries aren't converted, so an invalid one doesn't fail.
+    const std::string json = R"({"type": "FeatureCollection", "features": [)" + features + R"(,
+        {"type": "Feature", "id": "c", "geometry": {"type": "Bogus", "coordinates": [[1], "x", [2, [{"y": []}]]]}}]})";
+
+    rapidjson_document document;
+    document.Parse(json.c_str());
+
+    const auto full = std::get<feature_collection>(parse(valid));
+
+    feature_collection geometries = full;
+    feature_collection properties = full;
+    for (std::size_t i = 0; i < full.size(); ++i) {
+        geometries[i].properties.clear();
+        properties[i].geometry = empty{};
+    }
+    properties.push_back(feature{ empty{}, {}, identifier{ std::string("c") } });
+
+    assert(parse(valid, parse_options::geometry_only()) == geojson{ geometries });
+    assert(parse(json, parse_options::properties_only()) == geojson{ properties });
+    assert(parse_rapidjson(json, parse_options::properties_only()) == geojson{ properties });
+    assert(convert(document, convert_options{ 1, {}, false }) == geojson{ properties });
+    assert(convert<feature_collection>(document["features"], convert_options{ 2, {}, false }) == properties);
+
+    std::string message;
+    try {
+        parse(R"({"type": "Feature", "properties": {}})", parse_options::properties_only());
+    } catch (const std::runtime_error &err) {
+        message = err.what();
+    }
+    assert(message == "Feature must have a geometry property");
+
+    // Skipped geometries are still tokenized, so invalid JSON within them fails as it would otherwise.
+    for (const auto *invalid : {
+             R"({"type": "Feature", "geometry": {"type": "Point", "coordinates": [1, 2,]}, "properties": null})",
+             R"({"type": "Feature", "geometry": {"type": "Point", "coordinates": [[1, 2], [1.]]}})",
+             R"({"type": "Feature", "geometry": {"type": "Point", "coordinates": [[1, 2] [3]]}})",
+             R"({"type": "Feature", "geometry": {"type": "Point", "coordinates": [[1, 2], [3)",
+         }) {
+        std::string expected;
+        std::string actual;
+        try {
+            parse(invalid);
+        } catch (const std::runtime_error &err) {
+            expected = err.what();
+        }
+        try {
+            parse(invalid, parse_options::properties_only());
+        } catch (const std::runtime_error &err) {
+            actual = err.what();
+        }
+        assert(!expected.empty() && expected == actual);
+    }
+}
+
+static void testBoundingBoxes() {
+    const std::string features = R"(
+        {"type": "Feature", "geometry": {"type": "LineString", "coordinates": [[3, -1], [-2, 4], [1, 0]]}},
+        {"type": "Feature", "bbox": [0, 0, 10, 10], "geometry": {"type": "Point", "coordinates": [1, 1]}},
+        {"type": "Feature", "geometry": null, "bbox": "ignored"},
+        {"type": "Feature", "geometry": {"type": "GeometryCollection", "geometries": [
+            {"type": "Point", "coordinates": [-5, 2]},
+            {"type": "MultiPoint", "coordinates": [[1, 8]], "bbox": [0, -3, 0, 1, 9, 1]}]}})";
+    const std::string json = R"({"type": "FeatureCollection", "features": [)" + features + "]}";
+
+    const auto [result, bboxes] = parse_with_bboxes(json);
+    assert(result == parse(json));
+    assert(bboxes.features.size() == 4);
+    assert(bboxes.features[0] == box({ -2, -1 }, { 3, 4 }));
+    assert(bboxes.features[1] == box({ 0, 0 }, { 10, 10 }));
+    assert(!bboxes.features[2]);
+    assert(bboxes.features[3] == box({ -5, -3 }, { 1, 9 }));
+    assert(bboxes.root == box({ -5, -3 }, { 10, 10 }));
+    assert(parse_with_bboxes<feature_collection>("[" + features + "]").bboxes.root == bboxes.root);
+
+    // A "bbox" member of the FeatureCollection takes precedence over those of its features.
+    const auto declared = parse_with_bboxes(R"({"type": "FeatureCollection", "bbox": [1, 2, 3, 4], "features": [)" +
+                                            features + "]}");
+    assert(declared.bboxes.root == box({ 1, 2 }, { 3, 4 }));
+    assert(declared.bboxes.features == bboxes.features);
+
+    // Without geometries, only the boxes the input declares are known.
+    const auto properties = parse_with_bboxes(json, parse_options::properties_only());
+    assert(properties.bboxes.features == (std::vector<std::optional<box>>{ {}, box({ 0, 0 }, { 10, 10 }), {}, {} }));
+
+    const auto point = parse_with_bboxes<geometry>(R"({"type": "Point", "coordinates": [1, 2]})");
+    assert(point.bboxes.root == box({ 1, 2 }, { 1, 2 }));
+    assert(point.bboxes.features.empty());
+
+    // Computed boxes are written, and read back.
+    const auto &collection = std::get<feature_collection>(result);
+    assert(bounding_box(collection) == box({ -5, -1 }, { 3, 8 }));
+    assert(bounding_box(collection[2]) == std::nullopt);
+    const std::string written = stringify(collection, stringify_options{ -1, true });
+    const auto reread         = parse_with_bboxes(written);
+    assert(reread.result == result);
+    assert(reread.bboxes.root == bounding_box(collection));
+    for (std::size_t i = 0; i < collection.size(); ++i) {
+        assert(reread.bboxes.features[i] == bounding_box(collection[i]));
+    }
+    assert(stringify(collection) == stringify(collection, stringify_options{ -1, false }));
+    assert(stringify(geometry{ empty{} }, stringify_options{ -1, true }) == "null");
+}
+
+static void testInternedStrings() {
+    const std::string json = R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "id": "way/1", "geometry": {"type": "Point", "coordinates": [1, 2]},
+         "properties": {"highway": "residential", "name": "A rather long street name", "lanes": 2}},
+        {"type": "Feature", "id": 2, "geometry": {"type": "LineString", "coordinates": [[0, 0], [1, 1]]},
+         "properties": {"highway": "residential", "name": "A rather long street name", "highway": "primary",
+                        "tags": {"highway": ["residential", null, true]}}}]})";
+
+    string_table strings(16);
+    const auto collection = std::get<interned::feature_collection>(interned::parse(json, strings));
+    const auto expected   = std::get<feature_collection>(parse(json));
+    assert(collection.size() == 2);
+    for (std::size_t i = 0; i < collection.size(); ++i) {
+        assert(collection[i].geometry == expected[i].geometry);
+    }
+    assert(collection[0].id == interned::identifier{ std::string_view("way/1") });
+    assert(collection[1].id == interned::identifier{ std::uint64_t(2) });
+
+    // Keys and short values are stored once, and the first of duplicate keys is kept.
+    const auto &first  = collection[0].properties;
+    const auto &second = collection[1].properties;
+    assert(first.size() == 3 && second.size() == 3);
+    assert(first[0].first.data() == second[0].first.data());
+    const auto *highway = interned::find(second, "highway");
+    assert(highway && std::get<std::string_view>(*highway) == "residential");
+    assert(std::get<std::string_view>(*highway).data() == std::get<std::string_view>(first[0].second).data());
+    const auto &tags = std::get<interned::value::object_type>(*interned::find(second, "tags"));
+    assert(tags[0].first.data() == first[0].first.data());
+    assert((std::get<interned::value::array_type>(tags[0].second) ==
+            interned::value::array_type{ std::string_view("residential"), interned::null_value_t{}, true }));
+
+    // Longer values are stored as they are.
+    const auto &name = std::get<std::string_view>(*interned::find(first, "name"));
+    assert(name == std::get<std::string_view>(*interned::find(second, "name")));
+    assert(name.data() != std::get<std::string_view>(*interned::find(second, "name")).data());
+    // "way/1", "highway", "residential", "name", twice the long name, "lanes", "primary" of the duplicate
+    // key, and "tags".
+    assert(strings.size() == 9);
+
+    // Wide objects keep the first of duplicate keys and document order too.
+    std::string wide = R"({"type": "Feature", "geometry": null, "properties": {)";
+    for (int i = 0; i < 40; ++i) {
+        wide += R"("k)" + std::to_string(i % 30) + R"(": )" + std::to_string(i) + (i < 39 ? ", " : "}}");
+    }
+    string_table wideStrings(64);
+    const auto wideFeature = interned::parse<interned::feature>(wide, wideStrings);
+    assert(wideFeature.properties.size() == 30);
+    for (std::size_t i = 0; i < 30; ++i) {
+        assert(wideFeature.properties[i].first == "k" + std::to_string(i));
+        assert(std::get<std::uint64_t>(wideFeature.properties[i].second) == i);
+    }
+
+    const auto filtered = std::get<interned::feature_collection>(
+        interned::parse(json, strings, parse_options{ { property_mode::allow, { "lanes" } } }));
+    assert(filtered[0].properties.size() == 1 && filtered[1].properties.empty());
+    assert(interned::parse<interned::feature>(R"({"type": "Feature", "geometry": null})", strings).properties.empty());
+    assert(interned::parse<interned::feature_collection>(R"([{"type": "Feature", "geometry": null}])", strings).size() ==
+           1);
+
+    std::string message;
+    try {
+        interned::parse(R"({"type": "Feature", "id": [1], "geometry": null})", strings);
+    } catch (const std::runtime_error &err) {
+        message = err.what();
+    }
+    std::string expectedMessage;
+    try {
+        parse(R"({"type": "Feature", "id": [1], "geometry": null})");
+    } catch (const std::runtime_error &err) {
+        expectedMessage = err.what();
+    }
+    assert(!message.empty() && message == expectedMessage);
+}
+
+static void testFlatProperties() {
+    flat::property_map map;
+    assert(map.empty() && map.capacity() == flat::property_map::inline_capacity);
+    assert(map.emplace("name", std::string("Main Street")).second);
+    assert(!map.emplace(std::string("name"), std::string("Other Street")).second);
+    assert(map.emplace("lanes", std::uint64_t(2)).second);
+    assert(map.size() == 2 && map.capacity() == 2);
+    assert(map.at("name") == value(std::string("Main Street")));
+    assert(map.find("highway") == map.end() && !map.contains("highway") && map.count("lanes") == 1);
+    bool threw = false;
+    try {
+        map.at("highway");
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Members are kept in key order, and move to the heap past the inline capacity.
+    map["highway"] = std::string("residential");
+    map.emplace("bridge", true);
+    assert(map.size() == 4 && map.capacity() > 2);
+    std::vector<std::string> keys;
+    for (const auto &member : map) {
+        keys.push_back(member.first);
+    }
+    assert((keys == std::vector<std::string>{ "bridge", "highway", "lanes", "name" }));
+
+    flat::property_map copy = map;
+    assert(copy == map);
+    assert(copy.erase("bridge") == 1 && copy.erase("bridge") == 0);
+    assert(copy != map && copy.size() == 3);
+    flat::property_map moved = std::move(copy);
+    assert(moved.size() == 3 && copy.empty());
+    flat::property_map small{ { "lanes", std::uint64_t(2) } };
+    flat::property_map movedSmall = std::move(small);
+    assert(movedSmall.size() == 1 && small.empty() && movedSmall.at("lanes") == value(std::uint64_t(2)));
+
+    const auto converted = static_cast<value::object_type>(map);
+    assert(converted.size() == 4 && flat::property_map(converted) == map);
+
+    // Parses give the same features as parse(), with nested objects as the usual values.
+    const std::string json = R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "id": "way/1", "geometry": {"type": "Point", "coordinates": [1, 2]},
+         "properties": {"highway": "residential", "name": "Main Street", "lanes": 2, "oneway": true}},
+        {"type": "Feature", "geometry": null,
+         "properties": {"highway": "residential", "highway": "primary", "tags": {"a": [1, null]}}}]})";
+    const auto collection = std::get<flat::feature_collection>(flat::parse(json));
+    const auto expected   = std::get<feature_collection>(parse(json));
+    assert(collection.size() == expected.size());
+    for (std::size_t i = 0; i < collection.size(); ++i) {
+        assert(collection[i].geometry == expected[i].geometry);
+        assert(collection[i].id == expected[i].id);
+        assert(static_cast<value::object_type>(collection[i].properties) == expected[i].properties);
+    }
+    assert(collection[1].properties.at("highway") == value(std::string("residential")));
+    assert(collection[1].properties.at("tags").getObject());
+
+    const std::string allowed = R"([{"type": "Feature", "geometry": null, "properties": {"a": 1, "b": 2}}])";
+    const auto filtered =
+        flat::parse<flat::feature_collection>(allowed, parse_options{ { property_mode::allow, { "b" } } });
+    assert(filtered.size() == 1 && filtered[0].properties.size() == 1 && filtered[0].properties.contains("b"));
+    assert(flat::parse<flat::feature>(R"({"type": "Feature", "geometry": null})").properties.empty());
+}
+
+static void testColumnarFeatureCollection() {
+    const std::string json = R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "id": 7, "properties": {"highway": "residential", "lanes": 2},
+         "geometry": {"type": "LineString", "coordinates": [[0, 0], [1, 1], [2, 0]]}},
+        {"type": "Feature", "properties": {"lanes": 1}, "geometry": null},
+        {"type": "Feature", "id": "b", "properties": {},
+         "geometry": {"type": "MultiPolygon", "coordinates": [
+            [[[0, 0], [4, 0], [4, 4], [0, 0]], [[1, 1], [2, 1], [2, 2], [1, 1]]],
+            [[[5, 5], [6, 5], [6, 6], [5, 5]]]]}},
+        {"type": "Feature", "properties": {"highway": "primary"}, "geometry": {"type": "GeometryCollection",
+         "geometries": [
+            {"type": "Point", "coordinates": [9, 9]},
+            {"type": "GeometryCollection", "geometries": [
+                {"type": "MultiPoint", "coordinates": [[1, 2], [3, 4]]},
+                {"type": "GeometryCollection", "geometries": []}]},
+            {"type": "MultiLineString", "coordinates": [[[0, 1], [1, 0]], [[2, 3], [3, 2], [4, 4]]]},
+            {"type": "Polygon", "coordinates": [[[0, 0], [1, 0], [1, 1], [0, 0]]]}]}}]})";
+
+    const auto collection = std::get<feature_collection>(parse(json));
+    const columnar_feature_collection columns(collection);
+    assert(columns.size() == 4);
+    assert(feature_collection(columns) == collection);
+    assert(feature_collection(parse_columnar(json)) == collection);
+    // The keys are stored once however many features have them.
+    assert(columns.keys().size() == 2);
+    assert(columns.points().size() == 3 + 12 + 1 + 2 + 5 + 4);
+
+    const auto road = columns[0];
+    assert(road.id() == identifier{ std::uint64_t(7) });
+    assert(road.geometry().type() == geometry_type::line_string);
+    assert(road.geometry().points().size() == 3 && road.geometry().points()[2] == point(2, 0));
+    assert(road.property_count() == 2);
+    assert(road.find("highway") && *road.find("highway") == value("residential"));
+    assert(!road.find("missing") && !columns[1].find("highway"));
+    assert(columns[1].id() == identifier{} && columns[1].geometry().type() == geometry_type::empty);
+    assert(columns[1].geometry().size() == 0 && columns[1].geometry().points().empty());
+
+    const auto polygons = columns[2].geometry();
+    assert(polygons.size() == 2 && polygons.rings(0) == 2 && polygons.rings(1) == 1);
+    assert(polygons.ring(0, 1).size() == 4 && polygons.ring(0, 1)[0] == point(1, 1));
+    assert(polygons.points().size() == 12);
+
+    // Members of collections follow them, and their points are within those of the collection.
+    const auto members = columns[3].geometry();
+    assert(members.type() == geometry_type::geometry_collection && members.size() == 4);
+    assert(members.points().size() == 12);
+    assert(members.member(1).type() == geometry_type::geometry_collection);
+    assert(members.member(1).member(0).points().size() == 2);
+    assert(members.member(1).member(1).size() == 0);
+    assert(members.member(2).type() == geometry_type::multi_line_string && members.member(2).rings(0) == 2);
+    assert(geometry(members.member(3)) == geometry(polygon{ { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 0 } } }));
+    assert(feature(columns[3]) == collection[3]);
+
+    // Options apply as they do to parse.
+    const auto geometries = parse_columnar(json, parse_options::geometry_only());
+    assert(geometries.keys().empty() && geometries.points().size() == columns.points().size());
+    assert(parse_columnar(json, parse_options::properties_only()).points().empty());
+
+    // Without ids, none are stored.
+    columnar_feature_collection appended;
+    appended.push_back(feature{ point(1, 2) });
+    assert(appended.size() == 1 && appended[0].id() == identifier{});
+    assert(feature(appended[0]) == feature{ point(1, 2) });
+
+    // Moved features give up their property values and id instead of having them copied.
+    feature moved = collection[0];
+    moved.properties["name"] = std::string(100, 'n');
+    moved.id                 = std::string(100, 'i');
+    const feature expected   = moved;
+    appended.push_back(std::move(moved));
+    assert(feature(appended[1]) == expected);
+    assert(std::get<std::string>(moved.properties.at("name")).empty());
+    assert(std::get<std::string>(moved.id).empty());
+
+    for (const auto *invalid : { R"({"type": "Point", "coordinates": [1, 2]})", R"({"type": "FeatureCollection")" }) {
+        bool threw = false;
+        try {
+            parse_columnar(invalid);
+        } catch (const std::runtime_error &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+}
+
+static void testFeatureIndex() {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> coordinate(-180, 180);
+    std::uniform_real_distribution<double> extent(0, 5);
+
+    std::vector<std::optional<box>> bboxes;
+    for (std::size_t i = 0; i < 20000; ++i) {
+        if (i % 97 == 0) {
+            bboxes.emplace_back();
+            continue;
+        }
+        const double x = coordinate(random);
+        const double y = coordinate(random) / 2;
+        bboxes.push_back(box({ x, y }, { x + extent(random), y + extent(random) }));
+    }
+
+    const feature_index index(bboxes, index_options{ 1, 9 });
+    assert(index.size() == bboxes.size());
+
+    const auto bruteForce = [&](const box &query) {
+        std::vector<std::size_t> found;
+        for (std::size_t i = 0; i < bboxes.size(); ++i) {
+            if (bboxes[i] && query.min.x <= bboxes[i]->max.x && query.min.y <= bboxes[i]->max.y &&
+                query.max.x >= bboxes[i]->min.x && query.max.y >= bboxes[i]->min.y)
+                found.push_back(i);
+        }
+        return found;
+    };
+    for (std::size_t i = 0; i < 200; ++i) {
+        const double x    = coordinate(random);
+        const double y    = coordinate(random) / 2;
+        const double size = extent(random) * 4;
+        const box query({ x, y }, { x + size, y + size });
+        assert(index.query(query) == bruteForce(query));
+    }
+    // Boundaries touching count as intersecting.
+    assert(index.query(*bboxes[1]) == bruteForce(*bboxes[1]));
+    assert(index.query(box({ bboxes[1]->max.x, bboxes[1]->max.y }, { 1000, 1000 })) ==
+           bruteForce(box({ bboxes[1]->max.x, bboxes[1]->max.y }, { 1000, 1000 })));
+
+    // The index doesn't depend on the number of threads, and survives a round trip.
+    const std::string serialized = index.serialize();
+    assert(feature_index(bboxes, index_options{ 4, 9 }).serialize() == serialized);
+    const feature_index restored = feature_index::deserialize(serialized);
+    assert(restored.size() == index.size());
+    assert(restored.serialize() == serialized);
+    assert(restored.query(box({ -10, -10 }, { 10, 10 })) == bruteForce(box({ -10, -10 }, { 10, 10 })));
+
+    for (const auto &corrupt : { std::string("GJRT"), serialized.substr(0, serialized.size() - 1),
+                                 "XJRT" + serialized.substr(4) }) {
+        bool threw = false;
+        try {
+            feature_index::deserialize(corrupt);
+        } catch (const std::runtime_error &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    const feature_index empty;
+    assert(empty.size() == 0 && empty.query(box({ -180, -90 }, { 180, 90 })).empty());
+    assert(feature_index::deserialize(empty.serialize()).size() == 0);
+
+    // Built from a parse, or from the parsed features, features without coordinates aren't found.
+    const auto parsed = parse_with_bboxes<feature_collection>(R"([
+        {"type": "Feature", "geometry": {"type": "LineString", "coordinates": [[0, 0], [2, 2]]}},
+        {"type": "Feature", "geometry": null},
+        {"type": "Feature", "geometry": {"type": "Point", "coordinates": [5, 5]}},
+        {"type": "Feature", "geometry": {"type": "Point", "coordinates": [1, 1]}}])");
+    for (const auto &built : { feature_index(parsed.bboxes), feature_index(parsed.result) }) {
+        assert(built.size() == 4);
+        assert(built.query(box({ 1, 1 }, { 1, 1 })) == (std::vector<std::size_t>{ 0, 3 }));
+        assert(built.query(box({ -90, -90 }, { 90, 90 })) == (std::vector<std::size_t>{ 0, 2, 3 }));
+        assert(built.query(box({ 3, 3 }, { 4, 4 })).empty());
+    }
+}
+
+static void testParseWithStats() {
+    const std::string json = R"({"type": "FeatureCollection", "features": [{"type": "Feature", "id": 1, "geometry":
+        {"type": "Polygon", "coordinates": [[[0, 0], [1, 0], [1, 1], [0, 0]]]}, "properties": {"a": [1, 2]}}]})";
+
+    // The document is tokenized and converted in separate passes, which are timed and counted.
+    const auto [result, stats] = parse_with_stats(json);
+    assert(result == parse(json));
+    assert(stats.input_bytes == json.size());
+    assert(stats.document_bytes > 0 && stats.document_bytes <= stats.bytes_allocated);
+    assert(stats.allocations > 0 && stats.peak_bytes > 0 && stats.peak_bytes <= stats.bytes_allocated);
+    assert(stats.elapsed >= stats.tokenize + stats.convert && stats.convert >= stats.validate);
+    assert(stats.validate.count() > 0);
+
+    const auto filtered = parse_with_stats(json, parse_options::geometry_only());
+    assert(filtered.result == parse(json, parse_options::geometry_only()));
+    assert((parse_with_stats<geometry>(R"({"type": "Point", "coordinates": [1, 2]})").result ==
+            geometry{ point{ 1, 2 } }));
+
+    // The pmr variant counts every allocation from the resource, the result's included.
+    counting_resource resource;
+    {
+        const auto counted = pmr::parse_with_stats(json, resource);
+        const auto &collection = std::get<pmr::feature_collection>(counted.result);
+        assert(collection.size() == 1 && collection[0].properties.get_allocator().resource() == &resource);
+        assert(counted.stats.allocations == resource.allocations() && counted.stats.allocations > 0);
+        assert(counted.stats.bytes_allocated == resource.bytes_allocated());
+        assert(counted.stats.peak_bytes >= resource.bytes_in_use() && resource.bytes_in_use() > 0);
+        assert(counted.stats.tokenize.count() == 0 && counted.stats.convert.count() == 0);
+        assert(counted.stats.document_bytes == 0 && counted.stats.validate.count() > 0);
+
+        const auto again = pmr::parse_with_stats(json, resource);
+        assert(again.stats.allocations == counted.stats.allocations);
+    }
+    assert(resource.bytes_in_use() == 0);
+
+    const auto written = stringify_with_stats(result);
+    assert(written.result == stringify(result));
+    assert(written.stats.output_bytes == written.result.size());
+    assert(written.stats.allocations > 0 && written.stats.bytes_allocated >= written.result.size());
+
+    for (const auto *invalid : { R"({"type": "Point", "coordinates": [1, 2)",
+                                 R"({"type": "LineString", "coordinates": [[1, 2]]})" }) {
+        std::string expected;
+        try {
+            parse(invalid);
+        } catch (const std::runtime_error &err) {
+            expected = err.what();
+        }
+        try {
+            parse_with_stats(invalid);
+            assert(false && "Should have thrown an error");
+        } catch (const std::runtime_error &err) {
+            assert(err.what() == expected);
+        }
+        try {
+            pmr::parse_with_stats(invalid, resource);
+            assert(false && "Should have thrown an error");
+        } catch (const std::runtime_error &err) {
+            assert(err.what() == expected);
+        }
+    }
+}
+
+static void testLazyFeatureCollection() {
+    const std::string json = R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "id": "a", "geometry": {"type": "Point", "coordinates": [1, 2]}, "properties": {"n": 1}},
+        {"type": "Feature", "id": 7, "geometry": {"type": "LineString", "coordinates": [[1, 2]]}, "properties": null},
+        {"type": "Feature", "geometry": null, "properties": {"n": 3}},
+        5
+    ]})";
+
+    const lazy_feature_collection lazy(json);
+    assert(lazy.size() == 4 && !lazy.empty());
+
+    const auto expected = std::get<feature_collection>(parse(R"({"type": "FeatureCollection", "features": [)"
+                                                             R"({"type": "Feature", "id": "a", "geometry": )"
+                                                             R"({"type": "Point", "coordinates": [1, 2]}, )"
+                                                             R"("properties": {"n": 1}}]})"));
+    assert(lazy[0] == expected[0]);
+    assert(&lazy.at(0) == &lazy[0]);
+    assert(lazy.properties_at(2).at("n") == value(std::uint64_t(3)));
+    assert(std::holds_alternative<empty>(lazy.geometry_at(2)));
+
+    // The second feature's geometry is invalid, which only its geometry and the whole feature report.
+    assert(lazy.id_at(1) == identifier(std::uint64_t(7)));
+    assert(lazy.properties_at(1).empty());
+    try {
+        lazy.geometry_at(1);
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(std::string(err.what()).find("two or more") != std::string::npos);
+    }
+
+    assert(lazy.find(identifier(std::uint64_t(7))) == std::optional<std::size_t>(1));
+    assert(lazy.find(identifier(std::string("a"))) == std::optional<std::size_t>(0));
+    // The third feature has no id, which a null id doesn't find either.
+    assert(!lazy.find(identifier(null_value_t{})));
+
+    // Invalid features don't stop a search, neither for an id after them nor for a missing one.
+    const lazy_feature_collection invalidFirst(R"([{"type": "Nope", "id": 1}, 5,
+        {"type": "Feature", "id": [2], "geometry": null}, {"type": "Feature", "id": 3, "geometry": null}])");
+    assert(invalidFirst.find(identifier(std::uint64_t(3))) == std::optional<std::size_t>(3));
+    assert(invalidFirst.find(identifier(std::uint64_t(1))) == std::optional<std::size_t>(0));
+    assert(!invalidFirst.find(identifier(std::uint64_t(4))));
+    assert(!lazy.find(identifier(std::string("missing"))));
+
+    try {
+        lazy.at(3);
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(std::string(err.what()) == "Feature must be an object");
+    }
+    try {
+        lazy.at(4);
+        assert(false && "Should have thrown an error");
+    } catch (const std::out_of_range &) {
+    }
+
+    // Converting the whole collection throws the error of the first invalid feature, like convert() does.
+    try {
+        static_cast<feature_collection>(lazy);
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(std::string(err.what()).find("two or more") != std::string::npos);
+    }
+
+    std::ifstream input("test/fixtures/feature-collection.json");
+    std::stringstream buffer;
+    buffer << input.rdbuf();
+    const std::string valid = buffer.str();
+    lazy_feature_collection moved{ lazy_feature_collection(valid) };
+    // Features cached whole or in part, and ones not accessed, convert alike, and the cache stays valid.
+    const feature *first = &moved[0];
+    moved.id_at(1);
+    assert(feature_collection(moved) == std::get<feature_collection>(parse(valid)));
+    assert(&moved[0] == first && moved[0] == std::get<feature_collection>(parse(valid))[0]);
+
+    rapidjson_document d;
+    d.Parse(R"([{"type": "Feature", "geometry": null}])");
+    const lazy_feature_collection array(std::move(d));
+    assert(array.size() == 1 && array[0] == feature{ empty{} });
+
+    for (const auto *invalid : { R"({"type": "Feature", "geometry": null})", R"({"type": "FeatureCollection"})",
+                                 R"({"type": "FeatureCollection", "features": [)" }) {
+        try {
+            lazy_feature_collection{ std::string_view(invalid) };
+            assert(false && "Should have thrown an error");
+        } catch (const std::runtime_error &) {
+        }
+    }
+}
+
+static void testParseCoordinateType() {
+    using tile_point    = maplibre::geometry::point<std::int16_t>;
+    using tile_geometry = maplibre::geometry::geometry<std::int16_t>;
+
+    const std::string json = R"({"type": "LineString", "coordinates": [[1.4, 2.5], [-3.5, 4]]})";
+
+    const auto rounded = parse<tile_geometry>(json);
+    assert((rounded == tile_geometry{ maplibre::geometry::line_string<std::int16_t>{ { 1, 3 }, { -4, 4 } } }));
+
+    const auto quantized = parse<tile_geometry>(json, [](double x, double y) {
+        return tile_point{ std::int16_t(x * 10), std::int16_t(y * 10) };
+    });
+    assert((quantized == tile_geometry{ maplibre::geometry::line_string<std::int16_t>{ { 14, 25 }, { -35, 40 } } }));
+
+    const auto collection = parse<basic_geojson<float>>(R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "id": 1, "geometry": {"type": "Point", "coordinates": [0.1, 0.2]}}]})");
+    const auto &features = std::get<maplibre::feature::feature_collection<float>>(collection);
+    assert(features.size() == 1 && features[0].id == identifier{ std::uint64_t(1) });
+    assert(std::get<maplibre::geometry::point<float>>(features[0].geometry) ==
+           maplibre::geometry::point<float>(0.1f, 0.2f));
+
+    try {
+        parse<tile_geometry>(R"({"type": "Point", "coordinates": [32767.5, 0]})");
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(std::string(err.what()) == "coordinates must be within the range of the coordinate type");
+    }
+}
+
+static void testParsePmr() {
+    const std::string json = R"({"type": "FeatureCollection", "features": [{"type": "Feature", "id": "a",
+        "geometry": {"type": "LineString", "coordinates": [[1, 2], [3, 4]]},
+        "properties": {"name": "first", "name": "second", "tags": ["x", {"k": null}]}}]})";
+
+    std::pmr::monotonic_buffer_resource arena;
+    // Nothing of the result may be allocated from anywhere but the arena.
+    std::pmr::memory_resource *previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    const auto result = pmr::parse(json, &arena);
+    std::pmr::set_default_resource(previous);
+
+    const auto &features = std::get<pmr::feature_collection>(result);
+    assert(features.size() == 1);
+    assert(std::get<std::pmr::string>(features[0].id) == "a");
+    assert((std::get<pmr::line_string>(features[0].geometry) == pmr::line_string{ { 1, 2 }, { 3, 4 } }));
+
+    const auto &properties = features[0].properties;
+    assert(properties.size() == 2);
+    assert(std::get<std::pmr::string>(*pmr::find(properties, "name")) == "first");
+    const auto &tags = std::get<pmr::value::array_type>(*pmr::find(properties, "tags"));
+    assert(tags.size() == 2 && std::get<std::pmr::string>(tags[0]) == "x");
+    assert(std::holds_alternative<pmr::null_value_t>(*pmr::find(std::get<pmr::prop_map>(tags[1]), "k")));
+    assert(pmr::find(properties, "missing") == nullptr);
+
+    // Wide objects keep the first of duplicate keys and document order too.
+    std::string wide = R"({"type": "Feature", "geometry": null, "properties": {)";
+    for (int i = 0; i < 40; ++i) {
+        wide += R"("k)" + std::to_string(i % 30) + R"(": )" + std::to_string(i) + (i < 39 ? ", " : "}}");
+    }
+    const auto wideFeature = pmr::parse<pmr::feature>(wide, &arena);
+    assert(wideFeature.properties.size() == 30);
+    for (std::size_t i = 0; i < 30; ++i) {
+        assert(std::string_view(wideFeature.properties[i].first) == "k" + std::to_string(i));
+        assert(std::get<std::uint64_t>(wideFeature.properties[i].second) == i);
+    }
+}
+
+// Checks alignment explicitly, since x86_64 and aarch64 (also under qemu) tolerate misaligned loads that
+// fault on 32-bit ARM.
+static void testPoolAllocator() {
+    const auto isAligned = [](const void *p) {
+        return reinterpret_cast<std::uintptr_t>(p) % alignof(std::max_align_t) == 0;
+    };
+
+    pool_allocator allocator(256);
+    assert(allocator.Malloc(0) == nullptr);
+
+    std::vector<char *> blocks;
+    for (std::size_t size = 1; size < 100; size += 7) {
+        auto *block = static_cast<char *>(allocator.Malloc(size));
+        assert(isAligned(block));
+        std::memset(block, int(size), size);
+        blocks.push_back(block);
+    }
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        const std::size_t size = 1 + i * 7;
+        assert(blocks[i][0] == char(size) && blocks[i][size - 1] == char(size));
+    }
+
+    // Growing the latest block keeps it in place while the chunk has room, and copies it otherwise.
+    auto *last = static_cast<char *>(allocator.Malloc(3));
+    std::memcpy(last, "abc", 3);
+    assert(allocator.Realloc(last, 3, 40) == last);
+    auto *moved = static_cast<char *>(allocator.Realloc(blocks[0], 1, 1000));
+    assert(moved != blocks[0] && isAligned(moved) && moved[0] == char(1));
+    assert(allocator.Realloc(moved, 1000, 10) == moved);
+
+    assert(allocator.Size() <= allocator.Capacity());
+    allocator.Clear();
+    assert(allocator.Capacity() == 0);
+
+    // Pool documents own a pool, from which their members, elements and copied strings are allocated, and
+    // convert like other documents.
+    const std::string json = R"({"type": "FeatureCollection", "features": [{"type": "Feature", "id": 1,
+        "geometry": {"type": "Point", "coordinates": [1.5, 2]}, "properties": {"k": "v", "n": {"a": [1]}}}]})";
+    rapidjson_pool_document pooled;
+    pooled.Parse(json.c_str());
+    rapidjson_document d;
+    d.Parse(json.c_str());
+    assert(convert(pooled) == convert(d));
+    assert(convert<feature_collection>(pooled["features"]) == convert<feature_collection>(d["features"]));
+    assert(convert<feature>(pooled["features"][0], convert_options{ 1, { property_mode::allow, { "k" } }, false }) ==
+           convert<feature>(d["features"][0], convert_options{ 1, { property_mode::allow, { "k" } }, false }));
+
+    pooled["features"][0].RemoveMember("geometry");
+    d["features"][0].RemoveMember("geometry");
+    std::string message;
+    try {
+        convert(pooled);
+    } catch (const std::runtime_error &err) {
+        message = err.what();
+    }
+    std::string expected;
+    try {
+        convert(d);
+    } catch (const std::runtime_error &err) {
+        expected = err.what();
+    }
+    assert(!message.empty() && message == expected);
+}
+
+static void testConvertThreads() {
+    std::string json = R"({"type": "FeatureCollection", "features": [)";
+    for (int i = 0; i < 1000; ++i) {
+        json += (i ? "," : "") + std::string(R"({"type": "Feature", "id": )") + std::to_string(i) +
+                R"(, "geometry": {"type": "Point", "coordinates": [)" + std::to_string(i) + R"(, 0]}})";
+    }
+    json += "]}";
+
+    rapidjson_document d;
+    d.Parse(json.c_str());
+    const auto expected = convert<geojson>(d);
+    assert(std::get<feature_collection>(expected).size() == 1000);
+    convert_options options;
+    options.threads = 4;
+    assert(convert(d, options) == expected);
+    options.threads = 0;
+    assert(convert<feature_collection>(d["features"], options) == std::get<feature_collection>(expected));
+
+    // The first invalid feature is reported, however the chunks are scheduled.
+    d["features"][700].RemoveMember("geometry");
+    d["features"][300]["type"].SetString("Nope");
+    for (const unsigned threads : { 1u, 4u, 16u }) {
+        options.threads = threads;
+        try {
+            convert<geojson>(d, options);
+            assert(false && "Should have thrown an error");
+        } catch (const std::runtime_error &err) {
+            assert(std::string(err.what()) == "Feature type must be Feature");
+        }
+    }
+}
+
+static void testParseFile() {
+    // Every fixture reads like it does from memory, with the same errors for invalid ones.
+    for (const auto &entry : std::filesystem::directory_iterator("test/fixtures")) {
+        const std::string path = entry.path().string();
+        std::string fileMessage;
+        std::string memoryMessage;
+        geojson fromFile;
+        geojson fromMemory;
+        try {
+            fromFile = parse_file(path);
+        } catch (const std::runtime_error &err) {
+            fileMessage = err.what();
+        }
+        try {
+            fromMemory = readGeoJSON(path, false);
+        } catch (const std::runtime_error &err) {
+            memoryMessage = err.what();
+        }
+        assert(fileMessage == memoryMessage);
+        assert(fromFile == fromMemory);
+    }
+
+    const auto expected = readGeoJSON("test/fixtures/feature-collection.json", true);
+    assert(parse_file<geojson>("test/fixtures/feature-collection.json") == expected);
+
+    // A file ending at a page boundary is read in place, with the padding past it mapped separately.
+    const auto paged = std::filesystem::temp_directory_path() / "geojson-cpp-test-paged.json";
+    {
+        std::string point = R"({"type": "Point", "coordinates": [1, 2]})";
+        point.resize(4096, ' ');
+        std::ofstream(paged, std::ios::binary) << point;
+    }
+    assert((parse_file<geometry>(paged) == geometry{ point{ 1, 2 } }));
+    std::filesystem::remove(paged);
+
+    // A pipe can't be mapped and is read instead, here in several reads.
+    const auto fifo = std::filesystem::temp_directory_path() / "geojson-cpp-test.fifo";
+    std::filesystem::remove(fifo);
+    assert(::mkfifo(fifo.c_str(), 0600) == 0);
+    std::thread writer([&] {
+        std::ifstream fixture("test/fixtures/feature-collection.json");
+        std::ofstream(fifo) << fixture.rdbuf() << std::string(200000, ' ');
+    });
+    const auto piped = parse_file(fifo);
+    writer.join();
+    std::filesystem::remove(fifo);
+    assert(piped == expected);
+
+    try {
+        parse_file("test/fixtures/missing.json");
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(std::string(err.what()).rfind("cannot open test/fixtures/missing.json", 0) == 0);
+    }
+}
+
+static void testSeq() {
+    feature_collection features;
+    for (int i = 0; i < 200; ++i) {
+        feature f{ point{ double(i), -double(i) } };
+        f.id = std::uint64_t(i);
+        f.properties.emplace("name", "feature " + std::to_string(i));
+        features.push_back(std::move(f));
+    }
+
+    const seq_options options{ 3, 64 };
+    for (const auto format : { seq_format::newline_delimited, seq_format::rfc8142 }) {
+        std::ostringstream output;
+        seq_writer(output, format).write(features);
+        const std::string sequence = output.str();
+        assert(std::count(sequence.begin(), sequence.end(), '\n') == 200);
+
+        feature_collection ordered;
+        seq_reader reader(sequence, options);
+        for (auto &f : reader) {
+            ordered.push_back(std::move(f));
+        }
+        assert(ordered == features);
+
+        std::mutex mutex;
+        feature_collection unordered;
+        for_each_seq_feature(sequence, [&](feature &&f) {
+            std::lock_guard<std::mutex> lock(mutex);
+            unordered.push_back(std::move(f));
+        }, options);
+        std::sort(unordered.begin(), unordered.end(), [](const feature &a, const feature &b) {
+            return std::get<std::uint64_t>(a.id) < std::get<std::uint64_t>(b.id);
+        });
+        assert(unordered == features);
+    }
+
+    // Blank lines and carriage returns are skipped, and files read like memory.
+    const auto path = std::filesystem::temp_directory_path() / "geojson-cpp-test.geojsonl";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "\r\n" << stringify(features[0]) << "\r\n\n" << stringify(features[1]) << "\n";
+    }
+    std::vector<feature> read;
+    for (auto &f : seq_reader::open(path)) {
+        read.push_back(std::move(f));
+    }
+    assert(read.size() == 2 && read[0] == features[0] && read[1] == features[1]);
+    std::size_t count = 0;
+    for_each_seq_file_feature(path, [&](feature &&) { ++count; }, seq_options{ 1 });
+    assert(count == 2);
+    std::filesystem::remove(path);
+
+    // The first invalid record is thrown, once the records before it have been read.
+    const std::string valid = stringify(features[0]) + "\n";
+    std::string invalid;
+    for (int i = 0; i < 20; ++i) {
+        invalid += i == 7 ? "{\"type\": \"Point\"}\n" : i == 15 ? "{\n" : valid;
+    }
+    const std::string message = "record at byte " + std::to_string(7 * valid.size()) + ": Feature type must be Feature";
+
+    seq_reader reader(invalid, seq_options{ 4, 32 });
+    feature f;
+    for (int i = 0; i < 7; ++i) {
+        assert(reader.next(f) && f == features[0]);
+    }
+    try {
+        reader.next(f);
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(err.what() == message);
+    }
+    assert(!reader.next(f));
+
+    try {
+        for_each_seq_feature(invalid, [](feature &&) {}, seq_options{ 4, 32 });
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(err.what() == message);
+    }
+}
+
+static void testParseInsitu() {
+    const std::string json =
+        R"({"type": "Feature", "geometry": null, "properties": {"esc\"aped": "line\nbreak é", "n": 1}})";
+    std::string buffer = json + "trailing bytes that are not part of the input";
+
+    assert(parse_insitu(buffer.data(), json.size()) == parse(json));
+
+    // Interned results refer to the unescaped strings within the buffer, and filters apply.
+    const std::string collection = R"({"type": "FeatureCollection", "features": [{"type": "Feature", "id": "a",
+        "geometry": {"type": "Point", "coordinates": [1, 2]},
+        "properties": {"esc\"aped": "line\nbreak", "n": 1, "tags": {"k": ["v"]}, "n": 2}}]})";
+    buffer = collection;
+    const auto inside = [&](std::string_view string) {
+        return string.data() >= buffer.data() && string.data() + string.size() <= buffer.data() + buffer.size();
+    };
+    const auto parsed    = interned::parse_insitu(buffer.data(), buffer.size());
+    const auto &features = std::get<interned::feature_collection>(parsed);
+    string_table strings;
+    const auto expected = std::get<interned::feature_collection>(interned::parse(collection, strings));
+    assert(features.size() == 1 && features[0].geometry == expected[0].geometry);
+    assert(features[0].properties == expected[0].properties && features[0].id == expected[0].id);
+    const auto &properties = features[0].properties;
+    assert(properties.size() == 3 && properties[0].first == "esc\"aped" && inside(properties[0].first));
+    assert(std::get<std::string_view>(properties[0].second) == "line\nbreak");
+    assert(inside(std::get<std::string_view>(properties[0].second)));
+    assert(std::get<std::uint64_t>(*interned::find(properties, "n")) == 1);
+    const auto &tags = std::get<interned::value::object_type>(*interned::find(properties, "tags"));
+    assert(inside(tags[0].first) && inside(std::get<std::string_view>(features[0].id)));
+
+    buffer = collection;
+    const auto filtered = interned::parse_insitu(buffer.data(), buffer.size(), parse_options::geometry_only());
+    assert(std::get<interned::feature_collection>(filtered)[0].properties.empty());
+}
+
+static void testForEachFeature() {
+    const auto expected = std::get<feature_collection>(readGeoJSON("test/fixtures/feature-id.json", false));
+
+    feature_collection streamed;
+    std::ifstream input("test/fixtures/feature-id.json");
+    for_each_feature(input, [&](feature &&f) { streamed.push_back(std::move(f)); });
+    assert(streamed == expected);
+
+    streamed.clear();
+    std::FILE *file = std::fopen("test/fixtures/feature-id.json", "rb");
+    assert(file);
+    for_each_feature(file, [&](feature &&f) { streamed.push_back(std::move(f)); });
+    std::fclose(file);
+    assert(streamed == expected);
+
+    streamed.clear();
+    for_each_feature(R"({"features": [{"type": "Feature", "geometry": null}], "type": "FeatureCollection"})",
+                     [&](feature &&f) { streamed.push_back(std::move(f)); });
+    assert(streamed.size() == 1);
+
+    try {
+        for_each_feature(R"({"type": "FeatureCollection", "features": [{"type": "Feature"}]})", [](feature &&) {});
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(std::string(err.what()) == "Feature must have a geometry property");
+    }
+
+    try {
+        for_each_feature(R"({"type": "Point", "coordinates": [0, 0]})", [](feature &&) {});
+        assert(false && "Should have thrown an error");
+    } catch (const std::runtime_error &err) {
+        assert(std::string(err.what()).find("FeatureCollection") != std::string::npos);
+    }
+}
+
 void testAll(bool use_convert) {
     testPoint(use_convert);
     testMultiPoint(use_convert);
@@ -309,6 +1571,30 @@ void testAll(bool use_convert) {
 
 int main() {
     testParseErrorHandling();
+    testReaderMatchesDocument();
+    testReaderNumbersMatchDocument();
+    testStringifyMatchesDocument();
+    testStringifyPrecision();
+    testWrite();
+    testParseBuffer();
+    testParseBackends();
+    testPropertyFilter();
+    testParseModes();
+    testBoundingBoxes();
+    testFeatureIndex();
+    testColumnarFeatureCollection();
+    testInternedStrings();
+    testFlatProperties();
+    testParseWithStats();
+    testLazyFeatureCollection();
+    testParseCoordinateType();
+    testParsePmr();
+    testPoolAllocator();
+    testConvertThreads();
+    testParseFile();
+    testSeq();
+    testParseInsitu();
+    testForEachFeature();
     testEmpty();
     testAll(true);
     testAll(false);
@@ -1,4 +1,5 @@
 #include <maplibre/geojson.hpp>
+#include <maplibre/geojson/interned.hpp>
 #include <maplibre/geojson/rapidjson.hpp>
 #include <maplibre/geojson/value.hpp>
 #include <maplibre/geometry.hpp>
@@ -82,6 +83,69 @@ void test(const std::string &path, bool use_convert = false) {
     assert(std::holds_alternative<Expected>(result));
 }
 
+void testPropertyFilter() {
+    const std::string json = R"({"type": "Feature", "geometry": {"type": "Point", "coordinates": [1, 2]},
+        "properties": {"a": 1, "b": {"a": 2}, "c": "x"}})";
+    rapidjson_document d;
+    d.Parse<0>(json.c_str());
+    const maplibre::geojson::value convertedValue = toValue(d);
+
+    for (const property_filter &filter : { property_filter{ property_mode::allow, { "a", "b" } },
+                                           property_filter{ property_mode::deny, { "b" } },
+                                           property_filter{ property_mode::none, {} } }) {
+        const parse_options options{ filter };
+        const geojson expected = parse(json, options);
+        assert(convert(convertedValue, options) == expected);
+        assert(convert<feature>(convertedValue, options) == std::get<feature>(expected));
+        assert(convert(value{ json }, options) == expected);
+        assert(convert<feature_collection>(value{ value::array_type{ convertedValue } }, options) ==
+               feature_collection{ std::get<feature>(expected) });
+    }
+
+    for (const auto &options : { parse_options::geometry_only(), parse_options::properties_only() }) {
+        assert(convert(convertedValue, options) == parse(json, options));
+    }
+}
+
+void testInterned() {
+    const std::string json = R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "id": "a", "geometry": {"type": "Point", "coordinates": [1, 2]},
+         "properties": {"highway": "residential", "lanes": 2, "ref": [1, "x"]}},
+        {"type": "Feature", "id": 2, "geometry": {"type": "Point", "coordinates": [3, 4]},
+         "properties": {"highway": "residential", "tags": {"oneway": true}}}]})";
+    rapidjson_document d;
+    d.Parse<0>(json.c_str());
+    const maplibre::geojson::value convertedValue = toValue(d);
+
+    // Converted from a Value, features are those of a parse, with the same strings shared.
+    string_table strings;
+    const auto parsed    = std::get<interned::feature_collection>(interned::parse(json, strings));
+    const auto converted = std::get<interned::feature_collection>(interned::convert(convertedValue, strings));
+    assert(converted.size() == parsed.size());
+    for (std::size_t i = 0; i < parsed.size(); ++i) {
+        assert(converted[i].geometry == parsed[i].geometry);
+        assert(converted[i].id == parsed[i].id);
+        assert(converted[i].properties.size() == parsed[i].properties.size());
+        for (const auto &property : parsed[i].properties) {
+            const auto *found = interned::find(converted[i].properties, property.first);
+            assert(found && *found == property.second);
+        }
+    }
+    assert(std::get<std::string_view>(*interned::find(converted[1].properties, "highway")).data() ==
+           std::get<std::string_view>(*interned::find(parsed[0].properties, "highway")).data());
+    const std::size_t stored = strings.size();
+    interned::convert(convertedValue, strings);
+    assert(strings.size() == stored);
+
+    const auto &features = *convertedValue.getObject()->at("features").getArray();
+    const auto filtered  = interned::convert<interned::feature>(
+        features[0], strings, parse_options{ { property_mode::deny, { "highway" } } });
+    assert(filtered.properties.size() == 2 && !interned::find(filtered.properties, "highway"));
+    assert((interned::convert<interned::feature_collection>(value{ value::array_type{ features[1] } }, strings)
+                .front()
+                .id == interned::identifier{ std::uint64_t(2) }));
+}
+
 int main() {
     test("test/fixtures/null.json", true);
     test("test/fixtures/point.json");
@@ -96,6 +160,8 @@ int main() {
     test<feature>("test/fixtures/feature-missing-properties.json");
     test<feature_collection>("test/fixtures/feature-collection.json");
     test<feature_collection>("test/fixtures/feature-id.json");
+    testPropertyFilter();
+    testInterned();
     try {
         test("test/fixtures/array.json");
     } catch (const std::runtime_error &err) {